@@ -0,0 +1,217 @@
+/**
+ * @file src/aggregate.cpp
+ *
+ * @brief Aggregated, SIMD-vectorized simulator for large replica sweeps.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "aggregate.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "model.h"
+#include "parallel.h"
+
+// the kernel compiled once per instruction set; aggregate_lanes() picks at run time
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace avx512 {
+#include "aggregate_kernel.h"
+static void run_group(int a, int c, std::uint64_t seed, long first, int count, AggregateResult &out) {
+    run_lanes<16>(a, c, seed, first, count, out);
+}
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+#include "aggregate_kernel.h"
+static void run_group(int a, int c, std::uint64_t seed, long first, int count, AggregateResult &out) {
+    run_lanes<8>(a, c, seed, first, count, out);
+}
+}
+#pragma GCC pop_options
+
+namespace generic {
+#include "aggregate_kernel.h"
+static void run_group(int a, int c, std::uint64_t seed, long first, int count, AggregateResult &out) {
+    run_lanes<4>(a, c, seed, first, count, out);
+}
+}
+
+/**
+ * @brief Replicas per lane group on this CPU.
+ *
+ * @param void
+ *
+ * @return int 16 with AVX-512, 8 with AVX2, otherwise 4 (one SSE register).
+ */
+int aggregate_lanes() {
+    static const int lanes = __builtin_cpu_supports("avx512f") ? 16 : __builtin_cpu_supports("avx2") ? 8 : 4;
+    return lanes;
+}
+
+/**
+ * @brief Add another partial result of the same (A, C) into this one.
+ *
+ * @param other Partial result.
+ *
+ * @return void
+ */
+void AggregateResult::merge(const AggregateResult &other) {
+    if (other.replicas == 0) return;
+    replicas += other.replicas;
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+    makespan.merge(other.makespan);
+    tripsToMain = other.tripsToMain;
+    tripsToIsland = other.tripsToIsland;
+    twokidBoats = other.twokidBoats;
+    kidAdultBoats = other.kidAdultBoats;
+    soloBoats = other.soloBoats;
+    adultDrivers = other.adultDrivers;
+    childDrivers = other.childDrivers;
+}
+
+/**
+ * @brief Makespan statistics from the running sums and histogram.
+ *
+ * @param void
+ *
+ * @return Summary Mean, 95% CI half width and percentiles (seconds).
+ */
+Summary AggregateResult::summary() const {
+    Summary s;
+    s.n = replicas;
+    if (replicas == 0) return s;
+    s.mean = sum / replicas;
+    double var = replicas > 1 ? (sumSquares - sum * s.mean) / (replicas - 1) : 0;
+    s.stddev = var > 0 ? std::sqrt(var) : 0;
+    s.ciHalfWidth = 1.96 * s.stddev / std::sqrt(static_cast<double>(replicas));
+    s.min = makespan.percentile(0.0);
+    s.p50 = makespan.percentile(0.50);
+    s.p90 = makespan.percentile(0.90);
+    s.p99 = makespan.percentile(0.99);
+    s.max = makespan.percentile(1.0);
+    return s;
+}
+
+/**
+ * @brief Run `replicas` aggregated replicas of one (A, C) on all cores.
+ *
+ * @param adults Number of adults.
+ * @param children Number of children.
+ * @param seed Base seed; replica `i` uses `replica_seed(seed, i)`.
+ * @param replicas Number of replicas.
+ * @param threads Worker threads, 0 for one per hardware thread.
+ *
+ * @return AggregateResult Makespan distribution and counters.
+ */
+AggregateResult simulate_aggregate(int adults, int children, std::uint64_t seed,
+                                   long replicas, unsigned threads) {
+    const int lanes = aggregate_lanes();
+    void (*run_group)(int, int, std::uint64_t, long, int, AggregateResult &) =
+        lanes == 16 ? avx512::run_group : lanes == 8 ? avx2::run_group : generic::run_group;
+
+    unsigned workers = worker_count(threads);
+    std::vector<AggregateResult> partial(workers);
+    long groups = (replicas + lanes - 1) / lanes;
+    parallel_for(groups, workers, [&](long gi, unsigned w) {
+        long first = gi * lanes;
+        int count = static_cast<int>(std::min<long>(lanes, replicas - first));
+        run_group(adults, children, seed, first, count, partial[w]);
+    }, 256);
+
+    AggregateResult total;
+    for (auto &p : partial) total.merge(p);
+    return total;
+}
+
+/**
+ * @brief Seconds elapsed since `start`.
+ *
+ * @param start Start of the measured region.
+ *
+ * @return double Wall-clock seconds.
+ */
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Run `--aggregate` mode for one (A, C) and print the report.
+ *
+ * @param adults Number of adults.
+ * @param children Number of children.
+ * @param seed Base seed.
+ * @param replicas Number of replicas.
+ * @param threads Worker threads, 0 for one per hardware thread.
+ *
+ * @return int Process exit code.
+ */
+int run_aggregate(int adults, int children, std::uint64_t seed, long replicas, unsigned threads) {
+    auto start = std::chrono::steady_clock::now();
+    AggregateResult r = simulate_aggregate(adults, children, seed, replicas, threads);
+    double elapsed = seconds_since(start);
+
+    std::cout << "Aggregated Replica Summary" << std::endl;
+    std::cout << "Adults: " << adults << ", children: " << children << ", seed: " << seed << std::endl;
+    std::cout << "Replicas run: " << r.replicas << " (" << aggregate_lanes() << " per SIMD lane group)" << std::endl;
+    print_summary_line(std::cout, "Makespan (s)", r.summary());
+    std::cout << "Boat traveled to the mainland: " << r.tripsToMain << std::endl;
+    std::cout << "Boat returned to the island: " << r.tripsToIsland << std::endl;
+    std::cout << "Boats with 2 children: " << r.twokidBoats << std::endl;
+    std::cout << "Boats with 1 child and 1 adult: " << r.kidAdultBoats << std::endl;
+    std::cout << "Boats with only 1 person (child or adult): " << r.soloBoats << std::endl;
+    std::cout << "Times adults were the driver: " << r.adultDrivers << std::endl;
+    std::cout << "Times children were the driver: " << r.childDrivers << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Throughput: " << r.replicas / elapsed / 1e6 << " M replicas/s" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Print makespan statistics for every valid (a, c) up to the given sizes.
+ *
+ * @param maxAdults Largest number of adults.
+ * @param maxChildren Largest number of children.
+ * @param seed Base seed (each cell uses the same replica streams).
+ * @param replicas Replicas per cell.
+ * @param threads Worker threads, 0 for one per hardware thread.
+ *
+ * @return int Process exit code.
+ *
+ * @details Cells with c < a + 1 are skipped, as `parse_args` rejects them.
+ */
+int run_capacity_table(int maxAdults, int maxChildren, std::uint64_t seed, long replicas,
+                       unsigned threads) {
+    auto start = std::chrono::steady_clock::now();
+    long total = 0;
+
+    std::cout << "Capacity Table (" << replicas << " replicas per cell, seed " << seed << ")" << std::endl;
+    std::cout << "adults children trips mean_s ci95_s p50_s p90_s p99_s max_s" << std::endl;
+    for (int a = 1; a <= maxAdults; ++a) {
+        for (int c = a + 1; c <= maxChildren; ++c) {
+            AggregateResult r = simulate_aggregate(a, c, seed, replicas, threads);
+            Summary s = r.summary();
+            total += r.replicas;
+            std::cout << std::fixed << std::setprecision(2)
+                      << a << " " << c << " " << r.tripsToMain + r.tripsToIsland << " "
+                      << s.mean << " " << s.ciHalfWidth << " " << std::setprecision(0)
+                      << s.p50 << " " << s.p90 << " " << s.p99 << " " << s.max << std::endl;
+        }
+    }
+
+    double elapsed = seconds_since(start);
+    std::cout << std::fixed << std::setprecision(1)
+              << "Replicas run: " << total << " in " << elapsed << " s ("
+              << total / elapsed / 1e6 << " M replicas/s)" << std::endl;
+    return 0;
+}
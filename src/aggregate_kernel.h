@@ -0,0 +1,136 @@
+/**
+ * @file src/aggregate_kernel.h
+ *
+ * @brief Lane-group kernel of the aggregated simulator.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * GCC lowers vector operations for the target of the function they are
+ * written in, before inlining, so the kernel has to be compiled once per
+ * instruction set. `aggregate.cpp` includes this file several times, each
+ * time inside its own namespace and `#pragma GCC target` region; hence
+ * there is deliberately no include guard.
+ */
+
+// controller_loop steps: 0-3 are the adult cycle, then the children phase
+// (plain ints because vector operators do not take enums)
+static const int PAIR = 0, RETURN = 1, WITH_ADULT = 2, RETURN_AGAIN = 3, CHILDREN = 4, FINISHED = 5;
+static const int ON_ISLAND = ISLAND;
+
+/**
+ * @struct LaneGroup
+ *
+ * @brief Structure-of-arrays state of `W` replicas.
+ *
+ * Each field is one GCC vector of `W` int32 lanes. `W` is picked so a
+ * field fits a single register of the target (8 for AVX2, 16 for
+ * AVX-512); wider vectors get split by the compiler and lose most of the
+ * benefit.
+ */
+template <int W>
+struct LaneGroup {
+    typedef std::int32_t lanes_t __attribute__((vector_size(W * sizeof(std::int32_t))));
+    typedef std::uint32_t ulanes_t __attribute__((vector_size(W * sizeof(std::uint32_t))));
+
+    lanes_t adults, children, side, stage, clock;
+    ulanes_t rng;
+    lanes_t tripsToMain, tripsToIsland, twokidBoats, kidAdultBoats, soloBoats, childDrivers;
+};
+
+/**
+ * @brief Advance every lane of the group by one trip.
+ *
+ * @param g Lane group.
+ *
+ * @return bool false once every lane has finished.
+ *
+ * @details Mirrors `controller_loop`: first the same early exits (adult
+ *          cycle over, island empty before the second return, children
+ *          phase over), then exactly one crossing per active lane. Masks
+ *          are all-ones/all-zeros lanes, so `mask & 1` is 1 where the
+ *          condition holds.
+ */
+template <int W>
+static inline bool step(LaneGroup<W> &g) {
+    typedef typename LaneGroup<W>::lanes_t lanes_t;
+    lanes_t st = g.stage;
+    st = (st == PAIR && g.adults == 0) ? CHILDREN : st;
+    st = (st == RETURN_AGAIN && g.adults == 0 && g.children == 0) ? CHILDREN : st;
+    st = (st == CHILDREN && g.children == 0) ? FINISHED : st;
+
+    lanes_t active = st != FINISHED;
+    int any = 0;
+    for (int l = 0; l < W; ++l) any |= active[l];
+    if (!any) { g.stage = st; return false; }
+
+    lanes_t onIsland = g.side == ON_ISLAND;
+    lanes_t inChildren = st == CHILDREN;
+    lanes_t pair = (st == PAIR) | (inChildren & onIsland & (g.children >= 2));
+    lanes_t back = (st == RETURN) | (st == RETURN_AGAIN) | (inChildren & ~onIsland);
+    lanes_t withAdult = st == WITH_ADULT;
+    lanes_t soloChild = inChildren & onIsland & (g.children == 1);
+
+    g.children += (back & 1) - (pair & 2) - (withAdult & 1) - (soloChild & 1);
+    g.adults -= withAdult & 1;
+
+    g.tripsToMain += (pair | withAdult | soloChild) & 1;
+    g.tripsToIsland += back & 1;
+    g.twokidBoats += pair & 1;
+    g.kidAdultBoats += withAdult & 1;
+    g.soloBoats += (back | soloChild) & 1;
+    // a child is always available to row, so adults never drive in this controller
+    g.childDrivers += active & 1;
+
+    g.side ^= active & 1;
+    g.rng = g.rng * 1664525u + 1013904223u;
+    g.clock += active & (1 + (lanes_t)(g.rng >> 30));
+
+    g.stage = (active & (st < CHILDREN)) ? ((st + 1) & 3) : st;
+    return true;
+}
+
+/**
+ * @brief Run up to `W` replicas of one (A, C) to completion.
+ *
+ * @param adults Number of adults.
+ * @param children Number of children.
+ * @param seed Base seed.
+ * @param first Index of the first replica of the group.
+ * @param count Replicas in this group (the remaining lanes idle).
+ * @param out Result to add into.
+ *
+ * @return void
+ */
+template <int W>
+static inline void run_lanes(int adults, int children, std::uint64_t seed,
+                             long first, int count, AggregateResult &out) {
+    LaneGroup<W> g;
+    for (int l = 0; l < W; ++l) {
+        g.adults[l] = adults;
+        g.children[l] = children;
+        g.side[l] = ON_ISLAND;
+        g.stage[l] = l < count ? PAIR : FINISHED;
+        g.clock[l] = 0;
+        g.rng[l] = replica_seed(seed, first + l);
+    }
+    g.tripsToMain = g.tripsToIsland = g.twokidBoats = g.kidAdultBoats = g.soloBoats = g.childDrivers = g.clock;
+
+    while (step(g)) {}
+
+    for (int l = 0; l < count; ++l) {
+        out.sum += g.clock[l];
+        out.sumSquares += static_cast<double>(g.clock[l]) * g.clock[l];
+        out.makespan.add(g.clock[l]);
+    }
+    out.replicas += count;
+    out.tripsToMain = g.tripsToMain[0];
+    out.tripsToIsland = g.tripsToIsland[0];
+    out.twokidBoats = g.twokidBoats[0];
+    out.kidAdultBoats = g.kidAdultBoats[0];
+    out.soloBoats = g.soloBoats[0];
+    out.adultDrivers = 0;
+    out.childDrivers = g.childDrivers[0];
+}
@@ -0,0 +1,430 @@
+/**
+ * @file src/bench.cpp
+ *
+ * @brief Overhead of the instrumented engine against the uninstrumented one.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Runs the threaded simulation many times with zero-length trips and the
+ * narration discarded, so only coordination (locking, waking, seating) is
+ * left, alternating between `NoInstrumentation` and `FullInstrumentation`
+ * with tracing, lifecycle stamps and counters all switched on. Reports the
+ * median wall time per trip of each and the difference, plus hardware
+ * counters per trip (`perfcounters.h`), which are far less noisy than wall
+ * time when judging layout changes to `Person` and `Boat`.
+ *
+ * `--queue` benchmarks the `MpmcQueue` behind the shadow validator's trip
+ * ring instead: producers and consumers hammer one ring, and the same
+ * load runs against a mutex-protected `std::deque` for comparison.
+ *
+ * `--dock` benchmarks the waiting lines of the crew policies (`dock.h`,
+ * `triage.h`) the way the engine uses them: threads contend for one mutex,
+ * standing in for `Boat::mtx`, and under it take a person from a shore and
+ * queue them on the other. The first-fit scan over the same people runs
+ * as the baseline.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dock.h"
+#include "engine.h"
+#include "mpmc.h"
+#include "perfcounters.h"
+#include "stats.h"
+
+/**
+ * @brief Run one simulation and return its wall time.
+ *
+ * @param A Number of adults.
+ * @param C Number of children.
+ * @param trips Output: trips the run made.
+ * @param counters Counters to run around the simulation.
+ *
+ * @return double Wall time in nanoseconds.
+ */
+template <class Instr>
+double time_run(int A, int C, int &trips, PerfCounters &counters) {
+    std::ostream discard(nullptr);
+    Boat boat;
+    boat.adultsOnIsland = A;
+    boat.childrenOnIsland = C;
+    boat.out = &discard;
+    boat.tripUnit = std::chrono::microseconds(0);
+    boat.rng.seed(1);
+
+    ChromeTrace trace;
+    LifecycleLog lifecycle;
+    if (Instr::timestamps) {
+        boat.trace = &trace;
+        boat.lifecycle = &lifecycle;
+    }
+
+    auto people = init_people(&boat, A, C);
+    counters.start();
+    auto t0 = std::chrono::steady_clock::now();
+    run_simulation<Instr>(boat, people);
+    auto t1 = std::chrono::steady_clock::now();
+    counters.stop();
+    trips = boat.tripsToMain + boat.tripsToIsland;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+/**
+ * @class LockedQueue
+ *
+ * @brief Bounded FIFO behind one mutex, the baseline for `MpmcQueue`.
+ */
+template <class T>
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t capacity) : capacity(capacity) {}
+
+    bool try_push(const T &x) {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (items.size() >= capacity) return false;
+        items.push_back(x);
+        return true;
+    }
+
+    bool try_pop(T &out) {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (items.empty()) return false;
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mtx;
+    std::deque<T> items;
+    std::size_t capacity;
+};
+
+/**
+ * @struct QueueResult
+ *
+ * @brief Throughput and sampled per-call latency of one queue benchmark.
+ */
+struct QueueResult {
+    double seconds = 0;
+    std::vector<double> pushNs, popNs;
+};
+
+/**
+ * @brief Run `producers` x `ops` pushes against `consumers` popping threads.
+ *
+ * @param q Queue under test.
+ * @param producers Producer threads.
+ * @param consumers Consumer threads.
+ * @param ops Items per producer.
+ *
+ * @return QueueResult Wall time and every 64th successful call's latency.
+ *
+ * @details A full or empty queue makes the caller yield and retry; only
+ *          successful calls are timed.
+ */
+template <class Q>
+QueueResult bench_queue(Q &q, int producers, int consumers, long ops) {
+    using Clock = std::chrono::steady_clock;
+    QueueResult r;
+    std::vector<std::vector<double>> pushNs(producers), popNs(consumers);
+    std::atomic<long> left{ops * producers};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (long i = 0; i < ops; ++i) {
+                std::uint64_t item = static_cast<std::uint64_t>(p) << 40 | static_cast<std::uint64_t>(i);
+                bool sample = (i & 63) == 0;
+                auto t0 = sample ? Clock::now() : Clock::time_point{};
+                while (!q.try_push(item)) {
+                    std::this_thread::yield();
+                    if (sample) t0 = Clock::now();
+                }
+                if (sample) pushNs[p].push_back(std::chrono::duration<double, std::nano>(Clock::now() - t0).count());
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            long n = 0;
+            std::uint64_t item;
+            while (left.load(std::memory_order_relaxed) > 0) {
+                bool sample = (n & 63) == 0;
+                auto t0 = sample ? Clock::now() : Clock::time_point{};
+                if (!q.try_pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (sample) popNs[c].push_back(std::chrono::duration<double, std::nano>(Clock::now() - t0).count());
+                left.fetch_sub(1, std::memory_order_relaxed);
+                n++;
+            }
+        });
+    }
+
+    auto t0 = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &t : threads) t.join();
+    r.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    for (auto &v : pushNs) r.pushNs.insert(r.pushNs.end(), v.begin(), v.end());
+    for (auto &v : popNs) r.popNs.insert(r.popNs.end(), v.begin(), v.end());
+    return r;
+}
+
+/**
+ * @brief Benchmark `MpmcQueue` against `LockedQueue` and print both.
+ *
+ * @param producers Producer threads.
+ * @param consumers Consumer threads.
+ * @param ops Items per producer.
+ *
+ * @return int 0.
+ */
+static int run_queue_bench(int producers, int consumers, long ops) {
+    const std::size_t capacity = 1024;
+    std::cout << "Queue benchmark (" << producers << " producers, " << consumers << " consumers, "
+              << ops << " items each, capacity " << capacity << ")" << std::endl;
+    std::cout << std::left << std::setw(14) << "queue" << std::right << std::setw(12) << "Mitems/s"
+              << std::setw(12) << "push p50" << std::setw(12) << "push p99"
+              << std::setw(12) << "pop p50" << std::setw(12) << "pop p99" << std::endl;
+    auto row = [&](const char* name, const QueueResult &r) {
+        Summary push = summarize(r.pushNs), pop = summarize(r.popNs);
+        std::cout << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << producers * ops / r.seconds / 1e6 << std::setprecision(0)
+                  << std::setw(10) << push.p50 << "ns" << std::setw(10) << push.p99 << "ns"
+                  << std::setw(10) << pop.p50 << "ns" << std::setw(10) << pop.p99 << "ns" << std::endl;
+    };
+    {
+        MpmcQueue<std::uint64_t> q(capacity);
+        row("mpmc ring", bench_queue(q, producers, consumers, ops));
+    }
+    {
+        LockedQueue<std::uint64_t> q(capacity);
+        row("mutex+deque", bench_queue(q, producers, consumers, ops));
+    }
+    return 0;
+}
+
+/**
+ * @struct DockPerson
+ *
+ * @brief The fields of `Person` the waiting lines and `select_person` look at.
+ */
+struct DockPerson {
+    int id = 0;
+    bool isAdult = false;
+    Loc position = ISLAND;
+    enum Role { NONE, DRIVER, PASSENGER } role = NONE;
+    int consecutiveRows = 0;
+    bool needsBreak = false;
+    int priority = 0;
+    double deadline = 0;
+};
+
+/**
+ * @brief Run `threads` x `ops` take-and-requeue cycles under one mutex.
+ *
+ * @param policy Crew policy; first-fit scans, the others use their waiting line.
+ * @param people Number of children waiting.
+ * @param threads Contending threads.
+ * @param ops Cycles per thread.
+ *
+ * @return QueueResult Wall time and every 64th cycle's latency (lock wait included) in `popNs`.
+ *
+ * @details A cycle takes a child from the island (the mainland if the island
+ *          is empty), moves them across and queues them there, as a trip's
+ *          end does in the engine.
+ */
+static QueueResult bench_dock(Policy policy, int people, int threads, long ops) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<DockPerson> crowd(static_cast<std::size_t>(people));
+    Triage triage;
+    triage.classes = 3;
+    triage.deadline = 60;
+    for (int i = 0; i < people; ++i) crowd[i].id = i + 1;
+    assign_triage(crowd, triage);
+    auto line = make_waiting_line<DockPerson*>(policy, 0, crowd.size());
+    if (line) for (auto &p : crowd) line->arrive(&p);
+
+    std::mutex mtx;
+    std::size_t cursor = 0;
+    std::atomic<bool> go{false};
+    std::vector<std::vector<double>> cycleNs(threads);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (long i = 0; i < ops; ++i) {
+                bool sample = (i & 63) == 0;
+                auto t0 = sample ? Clock::now() : Clock::time_point{};
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    DockPerson* p = nullptr;
+                    for (Loc where : {ISLAND, MAINLAND}) {
+                        if (p) break;
+                        p = line ? line->take(false, where, false)
+                                 : select_person(crowd, false, where, false, policy, cursor);
+                    }
+                    p->position = p->position == ISLAND ? MAINLAND : ISLAND;
+                    if (line) line->arrive(p);
+                }
+                if (sample) cycleNs[t].push_back(std::chrono::duration<double, std::nano>(Clock::now() - t0).count());
+            }
+        });
+    }
+    QueueResult r;
+    auto t0 = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &t : pool) t.join();
+    r.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    for (auto &v : cycleNs) r.popNs.insert(r.popNs.end(), v.begin(), v.end());
+    return r;
+}
+
+/**
+ * @brief Benchmark the waiting line of every indexed policy against the scan.
+ *
+ * @param people Children waiting.
+ * @param threads Contending threads.
+ * @param ops Cycles per thread.
+ *
+ * @return int 0.
+ */
+static int run_dock_bench(int people, int threads, long ops) {
+    std::cout << "Dock benchmark (" << people << " children, " << threads << " threads on one mutex, "
+              << ops << " cycles each)" << std::endl;
+    std::cout << std::left << std::setw(14) << "waiting line" << std::right << std::setw(12) << "Mcycles/s"
+              << std::setw(12) << "cycle p50" << std::setw(12) << "cycle p99" << std::endl;
+    const std::pair<const char*, Policy> lines[] = {
+        {"first-fit", Policy::FIRST_FIT}, {"fifo", Policy::FIFO}, {"priority", Policy::PRIORITY}, {"edf", Policy::EDF}};
+    for (auto &l : lines) {
+        QueueResult r = bench_dock(l.second, people, threads, ops);
+        Summary cycle = summarize(r.popNs);
+        std::cout << std::left << std::setw(14) << l.first << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << threads * ops / r.seconds / 1e6 << std::setprecision(0)
+                  << std::setw(10) << cycle.p50 << "ns" << std::setw(10) << cycle.p99 << "ns" << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Entry point: `./bin/bench [adults children] [--runs N]`,
+ *        `./bin/bench --queue [producers consumers] [--ops N]` or
+ *        `./bin/bench --dock [people threads] [--ops N]`.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ *
+ * @return int 0 on success, 1 on bad arguments or mismatched runs.
+ */
+int main(int argc, char** argv) {
+    int A = 7, C = 9;
+    long runs = 200, ops = 200000;
+    bool queue = false, dock = false;
+    std::vector<std::string> positional;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--runs" && i + 1 < argc) runs = std::stol(argv[++i]);
+            else if (arg == "--ops" && i + 1 < argc) ops = std::stol(argv[++i]);
+            else if (arg == "--queue") queue = true;
+            else if (arg == "--dock") dock = true;
+            else positional.push_back(arg);
+        }
+        if (positional.size() == 2) {
+            A = std::stoi(positional[0]);
+            C = std::stoi(positional[1]);
+        } else if (!positional.empty()) {
+            throw 0;
+        } else if (queue) {
+            A = C = 4;
+        } else if (dock) {
+            A = 1000;
+            C = 4;
+        }
+        if (queue && dock) throw 0;
+    } catch (...) {
+        std::cerr << "usage: ./bin/bench [adults children] [--runs N]" << std::endl
+                  << "       ./bin/bench --queue [producers consumers] [--ops N]" << std::endl
+                  << "       ./bin/bench --dock [people threads] [--ops N]" << std::endl;
+        return 1;
+    }
+    if (queue) {
+        if (A <= 0 || C <= 0 || ops <= 0) {
+            std::cerr << "need producers, consumers and ops > 0" << std::endl;
+            return 1;
+        }
+        return run_queue_bench(A, C, ops);
+    }
+    if (dock) {
+        if (A <= 0 || C <= 0 || ops <= 0) {
+            std::cerr << "need people, threads and ops > 0" << std::endl;
+            return 1;
+        }
+        return run_dock_bench(A, C, ops);
+    }
+    if (A <= 0 || C < 2 || C < A + 1 || runs <= 0) {
+        std::cerr << "need adults > 0, children >= adults + 1 and runs > 0" << std::endl;
+        return 1;
+    }
+
+    // alternate the variants so drift in machine load hits both equally
+    std::vector<double> plain, full;
+    int plainTrips = 0, fullTrips = 0;
+    PerfCounters plainCounters, fullCounters;
+    for (long r = 0; r < runs; ++r) {
+        plain.push_back(time_run<NoInstrumentation>(A, C, plainTrips, plainCounters));
+        full.push_back(time_run<FullInstrumentation>(A, C, fullTrips, fullCounters));
+    }
+    if (plainTrips != fullTrips || plainTrips == 0) {
+        std::cerr << "variants made different trips (" << plainTrips << " vs " << fullTrips << ")" << std::endl;
+        return 1;
+    }
+
+    Summary p = summarize(plain), f = summarize(full);
+    std::cout << "Engine overhead (" << A << " adults, " << C << " children, "
+              << plainTrips << " trips, " << runs << " runs each, zero-length trips)" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "no instrumentation:   " << std::setw(9) << p.p50 / plainTrips << " ns/trip (median), p90 "
+              << p.p90 / plainTrips << std::endl;
+    std::cout << "full instrumentation: " << std::setw(9) << f.p50 / fullTrips << " ns/trip (median), p90 "
+              << f.p90 / fullTrips << std::endl;
+    std::cout << std::setprecision(1) << "overhead: " << 100.0 * (f.p50 - p.p50) / p.p50 << "%" << std::endl;
+
+    double trips = double(plainTrips) * runs;
+    std::cout << "Per trip" << std::setw(22) << "none" << std::setw(14) << "full" << std::setw(10) << "delta" << std::endl;
+    for (int c = 0; c < PC_COUNT; ++c) {
+        PerfCounter pc = static_cast<PerfCounter>(c);
+        std::cout << std::left << std::setw(20) << perf_counter_name(pc) << std::right;
+        if (!plainCounters.available(pc)) {
+            std::cout << std::setw(10) << "n/a" << std::endl;
+            continue;
+        }
+        double a = plainCounters.total(pc) / trips, b = fullCounters.total(pc) / trips;
+        std::cout << std::setprecision(1) << std::setw(10) << a << std::setw(14) << b
+                  << std::setw(9) << (a > 0 ? 100 * (b - a) / a : 0) << "%" << std::endl;
+    }
+    if (plainCounters.available(PC_CYCLES) && plainCounters.available(PC_INSTRUCTIONS)) {
+        std::cout << std::setprecision(2) << "IPC: " << plainCounters.total(PC_INSTRUCTIONS) / plainCounters.total(PC_CYCLES)
+                  << " none, " << fullCounters.total(PC_INSTRUCTIONS) / fullCounters.total(PC_CYCLES) << " full" << std::endl;
+    }
+    if (!plainCounters.why_unavailable().empty()) {
+        std::cout << "some counters unavailable (" << plainCounters.why_unavailable() << ")" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,341 @@
+/**
+ * @file src/checkpoint.cpp
+ *
+ * @brief Checkpoints of a threaded run in a memory-mapped file, and resuming from them.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "engine.h"
+
+// file layout: header, then two slots of SlotHeader + people + waiting line
+static const char MAGIC[8] = {'I', 'S', 'L', 'C', 'K', 'P', 'T', '1'};
+static const std::size_t RNG_TEXT = 8192; // an mt19937 prints as up to ~7 KB of text
+
+struct FileHeader {
+    char magic[8];
+    CheckpointConfig cfg;
+};
+
+struct SlotHeader {
+    std::uint64_t sequence;  // 0 = never written
+    std::uint64_t checksum;  // FNV-1a of everything after this field
+    std::int32_t stage, location, adultsOnIsland, childrenOnIsland;
+    std::int32_t tripsToMain, tripsToIsland;
+    std::int32_t twokidBoats, kidAdultBoats, soloBoats, adultDrivers, childDrivers;
+    std::int32_t waiting;    // entries of the waiting line
+    std::uint64_t cursor;
+    double clock;
+    std::int64_t stragglesInjected, crewReplaced;
+    char rng[RNG_TEXT], faultRng[RNG_TEXT];
+};
+
+struct PersonRecord {
+    std::int32_t position, consecutiveRows, needsBreak, priority;
+    double deadline, landedAt;
+};
+
+/**
+ * @brief FNV-1a hash of a byte range.
+ *
+ * @param p First byte.
+ * @param n Number of bytes.
+ *
+ * @return std::uint64_t Hash.
+ */
+static std::uint64_t fnv1a(const unsigned char* p, std::size_t n) {
+    std::uint64_t h = 1469598103934665603ULL;
+    for (std::size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ULL; }
+    return h;
+}
+
+/**
+ * @brief Bytes of one slot for a run of `people` people.
+ *
+ * @param people Adults plus children.
+ *
+ * @return std::size_t Slot size.
+ */
+static std::size_t slot_bytes(std::size_t people) {
+    return sizeof(SlotHeader) + people * (sizeof(PersonRecord) + sizeof(std::int32_t));
+}
+
+/**
+ * @brief Unmap the snapshot file.
+ */
+Checkpoint::~Checkpoint() {
+    if (base) munmap(base, bytes);
+}
+
+/**
+ * @brief Map an open snapshot file.
+ *
+ * @param fd Open file, closed by the caller.
+ * @param size File size.
+ * @param error Output: what went wrong.
+ *
+ * @return bool true on success.
+ */
+bool Checkpoint::map(int fd, std::size_t size, std::string &error) {
+    void* m = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED) { error = "cannot map " + path + ": " + std::strerror(errno); return false; }
+    base = static_cast<unsigned char*>(m);
+    bytes = size;
+    return true;
+}
+
+/**
+ * @brief Start of a slot.
+ *
+ * @param i Slot 0 or 1.
+ *
+ * @return unsigned char* Slot.
+ */
+unsigned char* Checkpoint::slot(int i) const {
+    return base + sizeof(FileHeader) + static_cast<std::size_t>(i) * slotBytes;
+}
+
+/**
+ * @brief Create (or truncate) a snapshot file with two empty slots.
+ *
+ * @param path File.
+ * @param cfg Configuration of the run, kept in the header.
+ * @param error Output: what went wrong.
+ *
+ * @return std::unique_ptr<Checkpoint> The mapped file, or nullptr.
+ */
+std::unique_ptr<Checkpoint> Checkpoint::create(const std::string &path, const CheckpointConfig &cfg, std::string &error) {
+    std::unique_ptr<Checkpoint> ck(new Checkpoint());
+    ck->cfg = cfg;
+    ck->path = path;
+    ck->slotBytes = slot_bytes(static_cast<std::size_t>(cfg.adults + cfg.children));
+    ck->next = cfg.every;
+    std::size_t size = sizeof(FileHeader) + 2 * ck->slotBytes;
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { error = "cannot create " + path + ": " + std::strerror(errno); return nullptr; }
+    bool ok = ftruncate(fd, static_cast<off_t>(size)) == 0;
+    if (!ok) error = "cannot size " + path + ": " + std::strerror(errno);
+    ok = ok && ck->map(fd, size, error);
+    close(fd);
+    if (!ok) return nullptr;
+    FileHeader h;
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.cfg = cfg;
+    std::memcpy(ck->base, &h, sizeof(h));
+    return ck;
+}
+
+/**
+ * @brief Map an existing snapshot file to resume from it.
+ *
+ * @param path File written by a run with `--checkpoint`.
+ * @param error Output: what is wrong with the file.
+ *
+ * @return std::unique_ptr<Checkpoint> The mapped file, or nullptr.
+ */
+std::unique_ptr<Checkpoint> Checkpoint::open(const std::string &path, std::string &error) {
+    std::unique_ptr<Checkpoint> ck(new Checkpoint());
+    ck->path = path;
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) { error = "cannot open " + path + ": " + std::strerror(errno); return nullptr; }
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(FileHeader);
+    if (!ok) error = path + ": not a checkpoint file";
+    ok = ok && ck->map(fd, static_cast<std::size_t>(st.st_size), error);
+    close(fd);
+    if (!ok) return nullptr;
+
+    FileHeader h;
+    std::memcpy(&h, ck->base, sizeof(h));
+    const CheckpointConfig &c = h.cfg;
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || c.adults <= 0 || c.children < 2 || c.classes < 1 ||
+        c.every < 1 || c.policy < 0 || c.policy > static_cast<std::int32_t>(Policy::EDF)) {
+        error = path + ": not a checkpoint file";
+        return nullptr;
+    }
+    ck->cfg = c;
+    ck->slotBytes = slot_bytes(static_cast<std::size_t>(c.adults + c.children));
+    if (ck->bytes != sizeof(FileHeader) + 2 * ck->slotBytes) {
+        error = path + ": truncated checkpoint file";
+        return nullptr;
+    }
+    return ck;
+}
+
+/**
+ * @brief Copy the simulation state into the older slot (controller only, under `Boat::mtx`).
+ *
+ * @param boat Boat, between trips with nobody assigned.
+ * @param people People of the boat.
+ *
+ * @return void
+ *
+ * @details The checksum and sequence number go in last, so the slot only
+ *          counts as written once all of it is. The pages are handed to
+ *          the kernel with `MS_ASYNC`; the controller does not wait for
+ *          the disk.
+ */
+void Checkpoint::save(Boat &boat, std::vector<std::unique_ptr<Person>> &people) {
+    auto t0 = std::chrono::steady_clock::now();
+    unsigned char* s = slot(static_cast<int>((sequence + 1) & 1));
+    SlotHeader* h = reinterpret_cast<SlotHeader*>(s);
+    PersonRecord* pr = reinterpret_cast<PersonRecord*>(s + sizeof(SlotHeader));
+    std::int32_t* line = reinterpret_cast<std::int32_t*>(pr + people.size());
+
+    h->stage = static_cast<std::int32_t>(boat.stage);
+    h->location = boat.location;
+    h->adultsOnIsland = boat.adultsOnIsland;
+    h->childrenOnIsland = boat.childrenOnIsland;
+    h->tripsToMain = boat.tripsToMain;
+    h->tripsToIsland = boat.tripsToIsland;
+    h->twokidBoats = boat.twokidBoats;
+    h->kidAdultBoats = boat.kidAdultBoats;
+    h->soloBoats = boat.soloBoats;
+    h->adultDrivers = boat.adultDrivers;
+    h->childDrivers = boat.childDrivers;
+    h->cursor = boat.cursor;
+    h->clock = boat.clock;
+    h->stragglesInjected = boat.stragglesInjected;
+    h->crewReplaced = boat.crewReplaced;
+    for (auto [rng, text] : {std::make_pair(&boat.rng, h->rng), std::make_pair(&boat.faultRng, h->faultRng)}) {
+        std::ostringstream os;
+        os << *rng;
+        std::string str = os.str();
+        std::size_t n = std::min(str.size(), RNG_TEXT - 1);
+        std::memcpy(text, str.data(), n);
+        text[n] = '\0';
+    }
+
+    for (std::size_t i = 0; i < people.size(); ++i) {
+        const Person &p = *people[i];
+        pr[i] = {p.position, p.consecutiveRows, p.needsBreak, p.priority, p.deadline, p.landedAt};
+    }
+    // the waiting line holds pointers; store indices into `people` (adults first, as init_people makes them)
+    waiting.clear();
+    if (boat.dock) boat.dock->line_up(waiting);
+    for (std::size_t k = 0; k < waiting.size(); ++k) {
+        const Person* p = waiting[k];
+        line[k] = p->isAdult ? p->id - 1 : cfg.adults + p->id - 1;
+    }
+    h->waiting = static_cast<std::int32_t>(waiting.size());
+
+    const unsigned char* body = s + offsetof(SlotHeader, stage);
+    h->checksum = fnv1a(body, slotBytes - offsetof(SlotHeader, stage));
+    h->sequence = ++sequence;
+    msync(base, bytes, MS_ASYNC);
+
+    next = boat.tripsToMain + boat.tripsToIsland + cfg.every;
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    saves++;
+    totalUs += us;
+    if (us > maxUs) maxUs = us;
+}
+
+/**
+ * @brief Load the newest intact slot into a boat and its people (before any thread starts).
+ *
+ * @param boat Boat set up from `config()`.
+ * @param people People created by `init_people` for this boat.
+ * @param error Output: what is wrong with the file.
+ *
+ * @return bool false if no slot is intact or the newest one contradicts itself.
+ *
+ * @details The waiting line is rebuilt from scratch in the saved order.
+ */
+bool Checkpoint::restore(Boat &boat, std::vector<std::unique_ptr<Person>> &people, std::string &error) {
+    const SlotHeader* best = nullptr;
+    for (int i = 0; i < 2; ++i) {
+        const unsigned char* s = slot(i);
+        const SlotHeader* h = reinterpret_cast<const SlotHeader*>(s);
+        if (h->sequence == 0 || (best && h->sequence < best->sequence)) continue;
+        std::size_t off = offsetof(SlotHeader, stage);
+        if (fnv1a(s + off, slotBytes - off) == h->checksum) best = h;
+    }
+    if (!best) { error = path + ": no complete checkpoint"; return false; }
+    const SlotHeader &h = *best;
+    const PersonRecord* pr = reinterpret_cast<const PersonRecord*>(reinterpret_cast<const unsigned char*>(best) + sizeof(SlotHeader));
+    const std::int32_t* line = reinterpret_cast<const std::int32_t*>(pr + people.size());
+
+    std::istringstream rng(std::string(h.rng, strnlen(h.rng, RNG_TEXT)));
+    std::istringstream faultRng(std::string(h.faultRng, strnlen(h.faultRng, RNG_TEXT)));
+    rng >> boat.rng;
+    faultRng >> boat.faultRng;
+    bool ok = rng && faultRng && h.stage >= 0 && h.stage <= static_cast<std::int32_t>(CrewStage::CHILDREN) &&
+              (h.location == ISLAND || h.location == MAINLAND) && h.waiting >= 0 &&
+              static_cast<std::size_t>(h.waiting) <= people.size();
+    int adults = 0, children = 0;
+    for (std::size_t i = 0; ok && i < people.size(); ++i) {
+        Person &p = *people[i];
+        const PersonRecord &r = pr[i];
+        ok = r.position == ISLAND || r.position == MAINLAND;
+        p.position = static_cast<Loc>(r.position);
+        p.consecutiveRows = r.consecutiveRows;
+        p.needsBreak = r.needsBreak != 0;
+        p.priority = r.priority;
+        p.deadline = r.deadline;
+        p.landedAt = r.landedAt;
+        if (p.position == ISLAND) (p.isAdult ? adults : children)++;
+    }
+    ok = ok && adults == h.adultsOnIsland && children == h.childrenOnIsland;
+    if (!ok) { error = path + ": checkpoint contradicts itself"; return false; }
+
+    boat.stage = static_cast<CrewStage>(h.stage);
+    boat.location = static_cast<Loc>(h.location);
+    boat.adultsOnIsland = h.adultsOnIsland;
+    boat.childrenOnIsland = h.childrenOnIsland;
+    boat.tripsToMain = h.tripsToMain;
+    boat.tripsToIsland = h.tripsToIsland;
+    boat.twokidBoats = h.twokidBoats;
+    boat.kidAdultBoats = h.kidAdultBoats;
+    boat.soloBoats = h.soloBoats;
+    boat.adultDrivers = h.adultDrivers;
+    boat.childDrivers = h.childDrivers;
+    boat.cursor = static_cast<std::size_t>(h.cursor);
+    boat.clock = h.clock;
+    boat.stragglesInjected = h.stragglesInjected;
+    boat.crewReplaced = h.crewReplaced;
+    if (boat.dock) {
+        boat.dock = make_waiting_line<Person*>(boat.policy, static_cast<std::size_t>(cfg.adults),
+                                               static_cast<std::size_t>(cfg.children));
+        for (std::int32_t k = 0; k < h.waiting; ++k) {
+            if (line[k] < 0 || static_cast<std::size_t>(line[k]) >= people.size()) {
+                error = path + ": checkpoint contradicts itself";
+                return false;
+            }
+            boat.dock->arrive(people[static_cast<std::size_t>(line[k])].get());
+        }
+    }
+
+    sequence = h.sequence;
+    resumedAt = h.tripsToMain + h.tripsToIsland;
+    next = resumedAt + cfg.every;
+    return true;
+}
+
+/**
+ * @brief Print how many checkpoints were taken and how long the controller paused for them.
+ *
+ * @param os Output stream.
+ *
+ * @return void
+ */
+void Checkpoint::print(std::ostream &os) const {
+    os << "Checkpoints: " << saves << " written to " << path << " every " << cfg.every << " trips";
+    if (saves > 0) os << ", pause mean " << totalUs / static_cast<double>(saves) << " us, max " << maxUs << " us";
+    if (resumedAt >= 0) os << "; resumed at trip " << resumedAt;
+    os << std::endl;
+}
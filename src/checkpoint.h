@@ -0,0 +1,119 @@
+/**
+ * @file src/checkpoint.h
+ *
+ * @brief Checkpoints of a threaded run in a memory-mapped file, and resuming from them.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Every `every` trips the controller copies the simulation state into a
+ * snapshot file mapped with `mmap`. It does so right before choosing the
+ * next crew. At that point nobody is assigned or travelling, and the
+ * controller holds `Boat::mtx`, so the copy sees a consistent state. The
+ * world stops only for a few `memcpy`s into the page cache. Writing the
+ * pages to disk is left to the kernel (`msync(MS_ASYNC)`).
+ *
+ * The file holds a header with the run's configuration and two slots. Each
+ * save goes into the older slot and carries a sequence number and an
+ * FNV-1a checksum. A save cut short by a crash therefore leaves the other
+ * slot intact, and `restore` takes the newest slot whose checksum holds.
+ *
+ * A slot holds:
+ *
+ * - the controller's stage in the adult cycle;
+ * - the boat: shore, island counts, trip statistics, round-robin cursor,
+ *   virtual clock and fault counters;
+ * - the trip-time and fault RNGs;
+ * - every person's shore, consecutive rows, break flag, priority class,
+ *   deadline and landing time;
+ * - the order of the waiting line (fifo, priority and edf policies).
+ *
+ * `--resume` rebuilds the people from the header, restores the newest
+ * slot before any thread starts and runs on from there. With the same
+ * seed, the summary equals that of a run never interrupted.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "policy.h"
+
+struct Boat;
+struct Person;
+
+/**
+ * @struct CheckpointConfig
+ *
+ * @brief Settings a resumed run needs to rebuild the same boat and people.
+ */
+struct CheckpointConfig {
+    std::int32_t adults = 0, children = 0;
+    std::int32_t policy = 0;   // Policy
+    std::int32_t classes = 1;  // priority classes
+    std::uint64_t seed = 0;
+    double deadline = 0;
+    double timeScale = 1;
+    double straggle = 0, straggleTime = 0, boardingTimeout = 0;
+    std::int64_t every = 100;  // trips between checkpoints
+};
+
+/**
+ * @class Checkpoint
+ *
+ * @brief Snapshot file of one threaded run, mapped for its whole duration.
+ */
+class Checkpoint {
+public:
+    ~Checkpoint();
+
+    Checkpoint(const Checkpoint &) = delete;
+    Checkpoint &operator=(const Checkpoint &) = delete;
+
+    static std::unique_ptr<Checkpoint> create(const std::string &path, const CheckpointConfig &cfg, std::string &error);
+    static std::unique_ptr<Checkpoint> open(const std::string &path, std::string &error);
+
+    const CheckpointConfig &config() const { return cfg; }
+
+    /**
+     * @brief Whether a checkpoint is due (called by the controller at every crew choice).
+     *
+     * @param trips Trips completed so far.
+     *
+     * @return bool true once `every` trips have passed since the last save.
+     */
+    bool due(long trips) const { return trips >= next; }
+
+    void save(Boat &boat, std::vector<std::unique_ptr<Person>> &people);
+    bool restore(Boat &boat, std::vector<std::unique_ptr<Person>> &people, std::string &error);
+
+    void print(std::ostream &os) const;
+
+private:
+    Checkpoint() = default;
+
+    bool map(int fd, std::size_t bytes, std::string &error);
+    unsigned char* slot(int i) const;
+
+    CheckpointConfig cfg;
+    std::string path;
+    unsigned char* base = nullptr;
+    std::size_t bytes = 0, slotBytes = 0;
+    std::uint64_t sequence = 0; // of the newest slot
+    long next = 0;              // trip count of the next save
+    std::vector<Person*> waiting; // scratch for the waiting line
+
+    // report
+    long saves = 0, resumedAt = -1;
+    double totalUs = 0, maxUs = 0;
+};
+
+#endif
@@ -0,0 +1,242 @@
+/**
+ * @file src/critpath.cpp
+ *
+ * @brief Critical-path analysis of an event trace written by `--event-log`.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Each trip is a small dependency graph: the controller decides the crew,
+ * the driver and (if any) the passenger each wake up and sit down, the
+ * driver departs once both are seated, arrives, notifies, and the controller
+ * observes the notification before choosing the next crew. Trips are
+ * chained through the controller, so the critical path of the makespan is
+ * the chain of each trip's longest branch, plus any gap between one trip's
+ * observation and the next selection.
+ *
+ * Because of that chain, the path can be attributed trip by trip as the
+ * file is read, keeping only the trips not yet observed in memory, so
+ * traces of any size are processed in one streaming pass.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "lifecycle.h"
+
+/**
+ * @enum Segment
+ *
+ * @brief Parts of the critical path.
+ */
+enum Segment { SEG_GAP, SEG_SELECTION, SEG_WAKEUP, SEG_SEATING, SEG_DEPARTURE, SEG_TRAVEL,
+               SEG_BOOKKEEPING, SEG_NOTIFICATION, SEG_COUNT };
+
+static const char* segmentNames[SEG_COUNT] = {
+    "between trips", "selection", "wakeup", "seating", "departure",
+    "travel", "bookkeeping", "notification",
+};
+
+/**
+ * @struct OpenTrip
+ *
+ * @brief Events of a trip seen so far.
+ */
+struct OpenTrip {
+    std::uint64_t at[LC_COUNT] = {};
+    bool seen[LC_COUNT] = {};
+};
+
+/**
+ * @struct CriticalPath
+ *
+ * @brief Running attribution of the critical path.
+ */
+struct CriticalPath {
+    double ns[SEG_COUNT] = {};
+    std::uint64_t first = 0, last = 0; // first select, last observe
+    bool started = false;
+    long trips = 0, incomplete = 0;
+    long twoPerson = 0, passengerCritical = 0;
+    double passengerExcess = 0; // how much later passengers sat down when they were critical
+
+    void add(const OpenTrip &t);
+};
+
+/**
+ * @brief Attribute one complete trip's longest branch.
+ *
+ * @param t Trip with every event up to `observe`.
+ *
+ * @return void
+ *
+ * @details The departure waits for whichever crew member sat down last;
+ *          that member's wakeup and seating are on the path, the other's
+ *          are slack.
+ */
+void CriticalPath::add(const OpenTrip &t) {
+    auto span = [&](LifecyclePoint a, LifecyclePoint b) {
+        return t.at[b] > t.at[a] ? double(t.at[b] - t.at[a]) : 0.0;
+    };
+
+    if (!started) {
+        first = t.at[LC_SELECT_START];
+        started = true;
+    } else if (t.at[LC_SELECT_START] > last) {
+        ns[SEG_GAP] += double(t.at[LC_SELECT_START] - last);
+    }
+    last = t.at[LC_OBSERVED];
+    trips++;
+
+    ns[SEG_SELECTION] += span(LC_SELECT_START, LC_DECIDED);
+    bool passengerLast = t.seen[LC_PASSENGER_SEATED] && t.at[LC_PASSENGER_SEATED] > t.at[LC_DRIVER_SEATED];
+    if (t.seen[LC_PASSENGER_SEATED]) twoPerson++;
+    if (passengerLast) {
+        passengerCritical++;
+        passengerExcess += span(LC_DRIVER_SEATED, LC_PASSENGER_SEATED);
+        ns[SEG_WAKEUP] += span(LC_DECIDED, LC_PASSENGER_WOKEN);
+        ns[SEG_SEATING] += span(LC_PASSENGER_WOKEN, LC_PASSENGER_SEATED);
+        ns[SEG_DEPARTURE] += span(LC_PASSENGER_SEATED, LC_DEPARTED);
+    } else {
+        ns[SEG_WAKEUP] += span(LC_DECIDED, LC_DRIVER_WOKEN);
+        ns[SEG_SEATING] += span(LC_DRIVER_WOKEN, LC_DRIVER_SEATED);
+        ns[SEG_DEPARTURE] += span(LC_DRIVER_SEATED, LC_DEPARTED);
+    }
+    ns[SEG_TRAVEL] += span(LC_DEPARTED, LC_ARRIVED);
+    ns[SEG_BOOKKEEPING] += span(LC_ARRIVED, LC_NOTIFIED);
+    ns[SEG_NOTIFICATION] += span(LC_NOTIFIED, LC_OBSERVED);
+}
+
+/**
+ * @brief Map an event name to its lifecycle point.
+ *
+ * @param name Event name from the trace.
+ *
+ * @return int Point, or -1 if unknown.
+ */
+static int point_of(const char* name) {
+    for (int p = 0; p < LC_COUNT; ++p)
+        if (std::strcmp(name, lifecycle_point_name(static_cast<LifecyclePoint>(p))) == 0) return p;
+    return -1;
+}
+
+/**
+ * @brief Parse one event line.
+ *
+ * @param line Text of the line.
+ * @param trip Output: trip number.
+ * @param point Output: lifecycle point.
+ * @param ns Output: timestamp.
+ *
+ * @return true if the line is a well-formed event.
+ *
+ * @details Crew ids after the timestamp of `decide` lines are ignored.
+ */
+static bool parse_event(const char* line, unsigned long &trip, int &point, std::uint64_t &ns) {
+    char* end;
+    trip = std::strtoul(line, &end, 10);
+    if (end == line) return false;
+    const char* p = end;
+    while (*p == ' ') p++;
+    char name[32];
+    std::size_t n = std::strcspn(p, " \n");
+    if (n == 0 || n >= sizeof name) return false;
+    std::memcpy(name, p, n);
+    name[n] = '\0';
+    point = point_of(name);
+    if (point < 0) return false;
+    ns = std::strtoull(p + n, &end, 10);
+    return end != p + n;
+}
+
+/**
+ * @brief Print the attribution and the what-if estimates.
+ *
+ * @param cp Finished analysis.
+ *
+ * @return void
+ */
+static void report(const CriticalPath &cp) {
+    double makespan = cp.started ? double(cp.last - cp.first) : 0;
+    auto ms = [](double ns) { return ns / 1e6; };
+    auto pct = [&](double ns) { return makespan > 0 ? 100 * ns / makespan : 0; };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Critical path: " << ms(makespan) << " ms over " << cp.trips << " trips";
+    if (cp.incomplete) std::cout << " (" << cp.incomplete << " unfinished trips ignored)";
+    std::cout << std::endl;
+    for (int s = 0; s < SEG_COUNT; ++s) {
+        std::cout << "  " << std::left << std::setw(15) << segmentNames[s] << std::right
+                  << std::setw(14) << ms(cp.ns[s]) << " ms " << std::setw(8) << std::setprecision(2)
+                  << pct(cp.ns[s]) << "%" << std::setprecision(3) << std::endl;
+    }
+    std::cout << "Passenger boarding was on the path in " << cp.passengerCritical << " of "
+              << cp.twoPerson << " two-person trips" << std::endl;
+
+    double handoff = cp.ns[SEG_WAKEUP] + cp.ns[SEG_SEATING] + cp.ns[SEG_DEPARTURE]
+                   + cp.ns[SEG_BOOKKEEPING] + cp.ns[SEG_NOTIFICATION];
+    auto whatIf = [&](const char* what, double saved) {
+        std::cout << "  if " << what << ", makespan would be " << ms(makespan - saved) << " ms (-"
+                  << std::setprecision(2) << pct(saved) << "%)" << std::setprecision(3) << std::endl;
+    };
+    std::cout << "What if:" << std::endl;
+    whatIf("the crew handoff were free (wakeup, seating, departure, bookkeeping, notification)", handoff);
+    whatIf("crew selection were free", cp.ns[SEG_SELECTION]);
+    whatIf("passengers were seated no later than drivers", cp.passengerExcess);
+    whatIf("only travel took time", makespan - cp.ns[SEG_TRAVEL]);
+}
+
+/**
+ * @brief Entry point: `./bin/critpath <events-file | ->`.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ *
+ * @return int 0 on success, 1 on unreadable or malformed input.
+ */
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: ./bin/critpath <events-file | ->" << std::endl;
+        return 1;
+    }
+    std::FILE* in = std::strcmp(argv[1], "-") == 0 ? stdin : std::fopen(argv[1], "r");
+    if (!in) {
+        std::cerr << "could not open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    CriticalPath cp;
+    std::map<unsigned long, OpenTrip> open; // trips not yet observed
+    char line[256];
+    long lineNo = 0;
+    while (std::fgets(line, sizeof line, in)) {
+        lineNo++;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        unsigned long trip;
+        int point;
+        std::uint64_t ns;
+        if (!parse_event(line, trip, point, ns)) {
+            std::cerr << argv[1] << ":" << lineNo << ": malformed event" << std::endl;
+            return 1;
+        }
+        OpenTrip &t = open[trip];
+        t.at[point] = ns;
+        t.seen[point] = true;
+        if (point == LC_OBSERVED) {
+            cp.add(t);
+            open.erase(trip);
+        }
+    }
+    if (in != stdin) std::fclose(in);
+    cp.incomplete = static_cast<long>(open.size());
+
+    report(cp);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file src/dock.h
+ *
+ * @brief Explicit waiting queues per shore and class, for the `fifo` policy.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The scan policies find a crew by walking every person. With `fifo`, people
+ * instead wait in queues per shore and age: everybody starts in the island
+ * queues, and each person is appended to the queue of the shore it reaches
+ * once its trip is over. The controller takes crews from the front, so
+ * people leave in the order they reached the shore. Rested and tired people
+ * wait in separate queues, so a pick costs O(1) instead of O(people). The
+ * queues are plain `std::deque`s guarded by the caller (`Boat::mtx` in the
+ * engine): every arrival and pick already happens under that lock, so a
+ * lock-free queue would only add atomic traffic, and a bounded one could
+ * refuse a person. `bench --dock` measures a pick and requeue under a
+ * contended mutex against the first-fit scan.
+ *
+ * A template over the person type, like the selection functions in
+ * `policy.h`, so the threaded engine and the sequential `Ferry` share it.
+ * Both hold it as a `WaitingLine`, the interface the priority index of
+ * `triage.h` implements as well.
+ */
+
+#ifndef DOCK_H
+#define DOCK_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "island.h"
+
+/**
+ * @class WaitingLine
+ *
+ * @brief Where free people wait when the policy keeps them in an index instead of scanning.
+ */
+template <class Ptr>
+class WaitingLine {
+public:
+    virtual ~WaitingLine() = default;
+
+    /**
+     * @brief Add a free person at the shore they are on.
+     *
+     * @param p Person (`role == NONE`).
+     *
+     * @return void
+     */
+    virtual void arrive(Ptr p) = 0;
+
+    /**
+     * @brief Remove and return the next suitable person.
+     *
+     * @param wantAdult true for adult, false for child.
+     * @param where Shore.
+     * @param excludeNeedsBreak Skip people who need a break.
+     * @param preferRested Prefer people below the consecutive-row limit.
+     *
+     * @return Ptr The person, or nullptr.
+     */
+    virtual Ptr take(bool wantAdult, Loc where, bool excludeNeedsBreak, bool preferRested = true) = 0;
+
+    /**
+     * @brief List everyone waiting, in an order that rebuilds the same line.
+     *
+     * @param out Output: the waiting people; `arrive` in this order restores the line.
+     *
+     * @return void
+     */
+    virtual void line_up(std::vector<Ptr> &out) = 0;
+};
+
+/**
+ * @class DockQueues
+ *
+ * @brief The waiting queues of one boat.
+ *
+ * Each shore and age has two queues: people below the consecutive-row
+ * limit and people at it. A person's row count cannot change while they
+ * wait, so nobody ever moves between the two. Every entry carries its
+ * arrival number, so a pick that accepts either kind still takes the
+ * earliest arrival.
+ */
+template <class Ptr>
+class DockQueues : public WaitingLine<Ptr> {
+public:
+    /**
+     * @brief Queue a free person at the shore they are on.
+     *
+     * @param p Person (`role == NONE`).
+     *
+     * @return void
+     */
+    void arrive(Ptr p) override {
+        queue(p->position, p->isAdult, p->consecutiveRows >= MAX_CONSECUTIVE).push_back({arrivals++, p});
+    }
+
+    /**
+     * @brief Take the earliest suitable arrival at a shore.
+     *
+     * @param wantAdult true for adult, false for child.
+     * @param where Shore.
+     * @param excludeNeedsBreak Skip people who need a break.
+     * @param preferRested Prefer people below the consecutive-row limit.
+     *
+     * @return Ptr The person, removed from their queue, or nullptr.
+     *
+     * @details O(1): only the two queue fronts are looked at. A person
+     *          needs a break exactly when they are at the row limit, so
+     *          `excludeNeedsBreak` rules out the tired queue. Without a
+     *          rested candidate the earliest tired one is taken, like the
+     *          second pass of `select_person`.
+     */
+    Ptr take(bool wantAdult, Loc where, bool excludeNeedsBreak, bool preferRested = true) override {
+        std::deque<Entry> &rested = queue(where, wantAdult, false);
+        std::deque<Entry> &tired = queue(where, wantAdult, true);
+        bool useTired = !excludeNeedsBreak && !tired.empty() &&
+                        (rested.empty() || (!preferRested && tired.front().first < rested.front().first));
+        std::deque<Entry> &q = useTired ? tired : rested;
+        if (q.empty()) return nullptr;
+        Ptr p = q.front().second;
+        q.pop_front();
+        return p;
+    }
+
+    /**
+     * @brief List everyone waiting in arrival order.
+     *
+     * @param out Output: the waiting people.
+     *
+     * @return void
+     */
+    void line_up(std::vector<Ptr> &out) override {
+        std::vector<Entry> all;
+        for (auto &shore : queues)
+            for (auto &age : shore)
+                for (auto &q : age) all.insert(all.end(), q.begin(), q.end());
+        std::sort(all.begin(), all.end(), [](const Entry &a, const Entry &b) { return a.first < b.first; });
+        for (const Entry &e : all) out.push_back(e.second);
+    }
+
+private:
+    using Entry = std::pair<std::uint64_t, Ptr>; // arrival number, person
+
+    std::deque<Entry> &queue(Loc where, bool adult, bool tired) { return queues[where == MAINLAND][adult][tired]; }
+
+    std::deque<Entry> queues[2][2][2]; // shore, age, at the row limit
+    std::uint64_t arrivals = 0;
+};
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file src/engine.cpp
+ *
+ * @brief Non-template parts of the threaded simulation core.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "engine.h"
+
+#include <iomanip>
+
+#include "stats.h"
+
+/**
+ * @brief Add another thread's counters and lock profile to these.
+ *
+ * @param o Stats to add.
+ *
+ * @return void
+ */
+void ThreadStats::merge(const ThreadStats &o) {
+    cvWaits += o.cvWaits;
+    wakeups += o.wakeups;
+    spuriousWakeups += o.spuriousWakeups;
+    spinYields += o.spinYields;
+    notifies += o.notifies;
+    tripsDriven += o.tripsDriven;
+    tripsRidden += o.tripsRidden;
+    lockAcquisitions += o.lockAcquisitions;
+    lockContended += o.lockContended;
+    lockWaitNs += o.lockWaitNs;
+    if (o.maxLockWaitNs > maxLockWaitNs) maxLockWaitNs = o.maxLockWaitNs;
+}
+
+/**
+ * @brief Initialize person objects and assign them to the boat.
+ *
+ * @param boat Pointer to the shared Boat instance.
+ * @param A Number of adults.
+ * @param C Number of children.
+ * @param triage Priority classes and deadlines to hand out.
+ *
+ * @return std::vector<std::unique_ptr<Person>> Container of created people.
+ *
+ * @details Allocates `A` adult and `C` child `Person` instances, sets their
+ *          initial positions to `ISLAND`, assigns the shared `boat` pointer,
+ *          and returns the owning vector of unique pointers. Policies that
+ *          keep a waiting line get it filled with everybody.
+ */
+std::vector<std::unique_ptr<Person>> init_people(Boat* boat, int A, int C, const Triage &triage) {
+    std::vector<std::unique_ptr<Person>> people;
+    people.reserve(A + C);
+    for (int i = 0; i < A; ++i) {
+        auto p = std::make_unique<Person>();
+        p->id = i+1;
+        p->isAdult = true;
+        p->position = ISLAND;
+        p->boat = boat;
+        people.push_back(std::move(p));
+    }
+    for (int i = 0; i < C; ++i) {
+        auto p = std::make_unique<Person>();
+        p->id = i+1;
+        p->isAdult = false;
+        p->position = ISLAND;
+        p->boat = boat;
+        people.push_back(std::move(p));
+    }
+    assign_triage(people, triage);
+    boat->dock = make_waiting_line<Person*>(boat->policy, A, C);
+    if (boat->dock) for (auto &p : people) boat->dock->arrive(p.get());
+    return people;
+}
+
+/**
+ * @brief Join all threads in people container.
+ *
+ * @param people Container of people whose threads will be joined.
+ *
+ * @return void
+ *
+ * @details Joins each person's thread if it is joinable to ensure clean
+ *          termination before the program exits.
+ */
+void join_threads(std::vector<std::unique_ptr<Person>> &people) {
+    for (auto &p : people) if (p->th.joinable()) p->th.join();
+}
+
+/**
+ * @brief Print a concise summary of the boat statistics.
+ *
+ * @param boat Reference to the Boat whose stats will be printed.
+ *
+ * @return void
+ *
+ * @details Prints trip counts and driver statistics collected during the
+ *          simulation to the boat's output stream.
+ */
+void print_summary(Boat &boat) {
+    std::ostream &out = *boat.out;
+    out << "Summary of Events" << std::endl;
+    out << "Boat traveled to the mainland: " << boat.tripsToMain << std::endl;
+    out << "Boat returned to the island: " << boat.tripsToIsland << std::endl;
+    out << "Boats with 2 children: " << boat.twokidBoats << std::endl;
+    out << "Boats with 1 child and 1 adult: " << boat.kidAdultBoats << std::endl;
+    out << "Boats with only 1 person (child or adult): " << boat.soloBoats << std::endl;
+    out << "Times adults were the driver: " << boat.adultDrivers << std::endl;
+    out << "Times children were the driver: " << boat.childDrivers << std::endl;
+}
+
+/**
+ * @brief Print the counters and lock profile of the controller and the people.
+ *
+ * @param boat Boat (holds the controller's stats).
+ * @param people People (each holds its own stats).
+ * @param os Output stream.
+ *
+ * @return void
+ *
+ * @details Only meaningful for engines built with counters or lock
+ *          profiling; the fields of disabled knobs stay zero.
+ */
+void print_counters(const Boat &boat, const std::vector<std::unique_ptr<Person>> &people, std::ostream &os) {
+    ThreadStats crew;
+    for (auto &p : people) crew.merge(p->stats);
+
+    std::ios::fmtflags flags = os.flags();
+    auto row = [&](const char* who, const ThreadStats &s) {
+        os << std::left << std::setw(12) << who << std::right
+           << std::setw(9) << s.cvWaits << std::setw(9) << s.wakeups << std::setw(10) << s.spuriousWakeups
+           << std::setw(8) << s.spinYields << std::setw(9) << s.notifies
+           << std::setw(8) << s.lockAcquisitions << std::setw(11) << s.lockContended
+           << std::setw(12) << s.lockWaitNs / 1000 << std::setw(12) << s.maxLockWaitNs / 1000 << std::endl;
+    };
+    os << "Engine Counters" << std::endl;
+    os << std::left << std::setw(12) << "thread" << std::right
+       << std::setw(9) << "waits" << std::setw(9) << "wakeups" << std::setw(10) << "spurious"
+       << std::setw(8) << "spins" << std::setw(9) << "notifies"
+       << std::setw(8) << "locks" << std::setw(11) << "contended"
+       << std::setw(12) << "wait us" << std::setw(12) << "max us" << std::endl;
+    row("controller", boat.controllerStats);
+    row("people", crew);
+    os << "Trips driven: " << crew.tripsDriven << ", ridden as passenger: " << crew.tripsRidden << std::endl;
+    os.flags(flags);
+}
+
+/**
+ * @brief Print the boat, the shore counts and every person's state.
+ *
+ * @param boat Boat.
+ * @param people People.
+ * @param os Output stream.
+ *
+ * @return void
+ *
+ * @details Used for stall reports; the caller decides whether it holds
+ *          `Boat::mtx`.
+ */
+void print_state(const Boat &boat, const std::vector<std::unique_ptr<Person>> &people, std::ostream &os) {
+    auto name = [](const Person* p) {
+        return !p ? std::string("none") : std::string(p->isAdult ? "Adult " : "Child ") + std::to_string(p->id);
+    };
+    static const char* roles[] = {"none", "driver", "passenger"};
+
+    os << "Boat: at the " << (boat.location == ISLAND ? "island" : "mainland")
+       << ", driver " << name(boat.driver) << ", passenger " << name(boat.passenger)
+       << ", boarded " << boat.boardedCount << std::endl;
+    os << "Island: " << boat.adultsOnIsland << " adults, " << boat.childrenOnIsland << " children" << std::endl;
+    for (auto &p : people) {
+        os << "  " << std::left << std::setw(10) << name(p.get()) << std::right
+           << " on the " << std::left << std::setw(9) << (p->position == ISLAND ? "island" : "mainland") << std::right
+           << " role " << std::left << std::setw(10) << roles[p->role] << std::right
+           << (p->seated ? " seated" : "") << (p->needsBreak ? " needs-break" : "")
+           << " rows " << p->consecutiveRows << std::endl;
+    }
+}
+
+/**
+ * @brief Print the straggler report: injected stalls, replacements, boarding times and makespan.
+ *
+ * @param boat Boat (after the run).
+ * @param makespan Wall-clock seconds of the run.
+ * @param os Output stream.
+ *
+ * @return void
+ *
+ * @details Boarding time runs from the controller assigning a crew to its
+ *          departure, including any replacements on the way.
+ */
+void print_boarding(const Boat &boat, double makespan, std::ostream &os) {
+    std::ios::fmtflags flags = os.flags();
+    os << "Boarding" << std::endl;
+    os << "Stragglers injected: " << boat.stragglesInjected << ", crew members replaced: " << boat.crewReplaced
+       << ", boarding timeout: ";
+    if (boat.boardingTimeout > 0) os << boat.boardingTimeout << " s";
+    else os << "off";
+    os << std::endl;
+    print_summary_line(os, "Boarding time (ms)", summarize(boat.boardingMs));
+    os << std::fixed << std::setprecision(3) << "Makespan: " << makespan << " s" << std::endl;
+    os.flags(flags);
+}
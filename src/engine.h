@@ -0,0 +1,889 @@
+/**
+ * @file src/engine.h
+ *
+ * @brief Threaded simulation core, compiled against an instrumentation policy.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * `Person::run` and `controller_loop` are templates over an `Instrumentation`
+ * policy whose knobs are compile-time constants:
+ *
+ * - Timestamps: Chrome trace spans and lifecycle stamps (`--chrome-trace`,
+ *   `--lifecycle`). When off, the trace and lifecycle pointers are constant
+ *   null, so every hook folds away.
+ * - Counters: cv waits, wakeups, spurious wakeups, spin yields, notifies.
+ * - LockProfiling: acquisitions of `Boat::mtx`, how many were contended and
+ *   how long they waited.
+ * - Probes: the USDT probes from `probes.h`.
+ * - Recorder: the always-on flight recorder from `flight.h`, dumped when the
+ *   controller stops with people still on the island.
+ * - Phases: each thread publishes its current phase for the sampling
+ *   profiler in `profiler.h` (`--profile`).
+ * - Faults: `Boat::straggleRate` makes woken crew members stall before
+ *   taking their seat (fault injection), `Boat::boardingTimeout` makes the
+ *   controller replace anyone who has not seated in time, and
+ *   `Boat::trackBoarding` times each boarding.
+ * - Capture: with `Boat::record` set every seat and departure is recorded
+ *   for replay (`record.h`), and with `Boat::checkpoint` set the controller
+ *   snapshots the run between trips (`checkpoint.h`); `Boat::stage` is what
+ *   lets it resume mid-cycle.
+ * - Shadow: with `Boat::shadow` set each driver hands its trip to the
+ *   shadow validator of `shadow.h`.
+ * - Scheduling: the waiting lines of the fifo, priority and edf policies
+ *   (`Boat::dock`) and the virtual clock that stamps landing times for
+ *   deadlines. Without it every pick is the `select_person` scan.
+ *
+ * Counters also maintain `Boat::tripsCompleted`, which the optional
+ * `Watchdog` (`watchdog.h`) watches for progress.
+ *
+ * `NoInstrumentation` turns everything off and leaves the plain
+ * lock/wait/sleep sequence of the original simulation.
+ *
+ * All locking, waiting, sleeping and thread creation goes through the
+ * names of `sync.h`, so `bin/island-explore` can run this same code under
+ * its controlled scheduler.
+ */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "checkpoint.h"
+#include "flight.h"
+#include "island.h"
+#include "lifecycle.h"
+#include "policy.h"
+#include "probes.h"
+#include "profiler.h"
+#include "record.h"
+#include "shadow.h"
+#include "sync.h"
+#include "trace.h"
+#include "triage.h"
+#include "watchdog.h"
+
+/**
+ * @struct Instrumentation
+ *
+ * @brief Compile-time selection of the instrumentation built into the engine.
+ */
+template <bool Timestamps, bool Counters, bool LockProfiling, bool Probes, bool Recorder, bool Phases, bool Faults,
+          bool Capture, bool Shadow, bool Scheduling>
+struct Instrumentation {
+    static constexpr bool timestamps = Timestamps;
+    static constexpr bool counters = Counters;
+    static constexpr bool lockProfiling = LockProfiling;
+    static constexpr bool probes = Probes;
+    static constexpr bool recorder = Recorder;
+    static constexpr bool phases = Phases;
+    static constexpr bool faults = Faults;
+    static constexpr bool capture = Capture;
+    static constexpr bool shadow = Shadow;
+    static constexpr bool scheduling = Scheduling;
+};
+
+using NoInstrumentation = Instrumentation<false, false, false, false, false, false, false, false, false, false>;
+using FullInstrumentation = Instrumentation<true, true, true, true, true, true, true, true, true, true>;
+
+/**
+ * @struct ThreadStats
+ *
+ * @brief Counters and lock profile of one thread (written only by that thread).
+ */
+struct ThreadStats {
+    // counters
+    long cvWaits = 0;         // calls to a condition variable wait
+    long wakeups = 0;         // returns from the wait that re-checked the predicate
+    long spuriousWakeups = 0; // ... and found nothing to do
+    long spinYields = 0;      // driver yields while the passenger boards
+    long notifies = 0;        // notify_one/notify_all calls
+    long tripsDriven = 0, tripsRidden = 0;
+
+    // lock profile of Boat::mtx
+    long lockAcquisitions = 0;
+    long lockContended = 0;   // acquisitions where try_lock failed
+    std::uint64_t lockWaitNs = 0, maxLockWaitNs = 0;
+
+    void merge(const ThreadStats &o);
+};
+
+struct Boat;
+
+/**
+ * @brief Where the controller is in its crossing plan: the four steps that
+ *        ship one adult, then the children alone.
+ */
+enum class CrewStage { ADULT_PAIR, ADULT_RETURN, ADULT_WITH_CHILD, ADULT_RETURN_AGAIN, CHILDREN };
+
+/**
+ * @struct Person
+ *
+ * @brief Represents a person (adult or child) trying to cross between island and mainland.
+ *
+ * The struct contains the person's ID, type (adult/child), current position,
+ * consecutive rowing count, role in the boat (driver/passenger/none), and
+ * threading constructs for synchronization.
+ */
+struct Person {
+    int id;
+    bool isAdult;
+    Loc position = ISLAND;
+    int consecutiveRows = 0; // how many times they've rowed in a row
+
+    // assignment state (protected by boat->mtx)
+    enum Role { NONE, DRIVER, PASSENGER } role = NONE;
+    bool seated = false;
+    bool needsBreak = false; // true when reached MAX_CONSECUTIVE and needs a break
+
+    // triage (see triage.h): class, deadline and last landing, in virtual seconds
+    int priority = 0;
+    double deadline = 0;
+    double landedAt = 0;
+
+    CondVar cv;
+    Thread th;
+
+    Boat* boat = nullptr;
+    ThreadStats stats;
+
+    template <class Instr> void run();
+};
+
+/**
+ * @struct Boat
+ *
+ * @brief Represents the state of the boat and manages synchronization between persons.
+ *
+ * The struct contains mutexes and condition variables for thread synchronization,
+ * the current location of the boat, counts of adults and children on the island,
+ * pointers to the current driver and passenger, and various statistics.
+ */
+struct Boat {
+    Mutex mtx;
+    CondVar tripDoneCv; // controller waits for trip completion
+    CondVar boardedCv;  // a crew member sat down (boarding timeouts only)
+
+    Loc location = ISLAND;
+
+    int adultsOnIsland = 0;
+    int childrenOnIsland = 0;
+
+    Person* driver = nullptr;
+    Person* passenger = nullptr;
+    int boardedCount = 0;
+
+    // stats
+    int tripsToMain = 0, tripsToIsland = 0;
+    int twokidBoats = 0, kidAdultBoats = 0, soloBoats = 0;
+    int adultDrivers = 0, childDrivers = 0;
+
+    // crew selection
+    Policy policy = Policy::FIRST_FIT;
+    std::size_t cursor = 0; // round-robin position
+    std::unique_ptr<WaitingLine<Person*>> dock; // fifo, priority and edf policies only
+
+    // virtual time: the sum of the trip times so far
+    double clock = 0;
+    // controller's next step (guarded by mtx)
+    CrewStage stage = CrewStage::ADULT_PAIR;
+
+    // optional per-thread timeline recording (--chrome-trace)
+    ChromeTrace* trace = nullptr;
+    // optional per-trip lifecycle timestamps (--lifecycle), guarded by mtx
+    LifecycleLog* lifecycle = nullptr;
+    // optional shadow validator fed by every driver (--shadow)
+    ShadowValidator* shadow = nullptr;
+    // optional record of seats and departures (--record), guarded by mtx
+    RunRecord* record = nullptr;
+    // optional snapshots between trips (--checkpoint), written by the controller
+    Checkpoint* checkpoint = nullptr;
+    // controller's counters and lock profile
+    ThreadStats controllerStats;
+    // progress for the watchdog (counters only); 0 ms = no watchdog
+    std::atomic<long> tripsCompleted{0};
+    std::chrono::milliseconds watchdog{0};
+    bool watchdogAbort = false;
+
+    // where the narration goes, and how long one unit of trip time lasts
+    std::ostream* out = &std::cout;
+    std::chrono::microseconds tripUnit{1000000};
+
+    // stragglers: chance that a woken crew member stalls for straggleTime
+    // trip-time seconds before seating, and how long the controller waits
+    // for a seat before replacing them (0 = forever); all guarded by mtx
+    double straggleRate = 0, straggleTime = 0, boardingTimeout = 0;
+    std::mt19937 faultRng{std::random_device{}()};
+    long stragglesInjected = 0, crewReplaced = 0;
+    bool trackBoarding = false;                      // record boardingMs
+    std::chrono::steady_clock::time_point assignedAt;
+    std::vector<double> boardingMs;                  // assignment to departure, per trip
+
+    // RNG
+    std::mt19937 rng{std::random_device{}()};
+    // RNG for 1–4 second trip time said by the homework requirements
+    std::uniform_int_distribution<int> dist{1,4};
+
+    /**
+     * @brief Generates a random trip time between 1 and 4 seconds.
+     *
+     * @param void
+     *
+     * @return int Random trip time in seconds.
+     *
+     * @details Uses the boat's internal uniform distribution and RNG to produce a value in the inclusive range [1,4].
+     */
+    int tripTime() { return dist(rng); }
+
+    /**
+     * @brief Decide whether a crew member who just woke up stalls.
+     *
+     * @param void
+     *
+     * @return bool true with probability `straggleRate`.
+     */
+    bool straggles() {
+        if (straggleRate <= 0 || std::uniform_real_distribution<double>(0, 1)(faultRng) >= straggleRate) return false;
+        stragglesInjected++;
+        return true;
+    }
+};
+
+/**
+ * @brief Acquire `Boat::mtx`, profiling the acquisition if enabled.
+ *
+ * @param m The boat mutex.
+ * @param st Calling thread's stats.
+ * @param trace Trace (null when not tracing).
+ * @param tb Calling thread's trace buffer (null when not tracing).
+ *
+ * @return void
+ *
+ * @details With lock profiling an uncontended `try_lock` counts as a zero
+ *          wait; otherwise the blocking `lock()` is timed. The thread's
+ *          phase is "locking" until it holds the mutex and "holding" after.
+ */
+template <class Instr>
+inline void lock_boat(Mutex &m, ThreadStats &st, const ChromeTrace* trace, TraceBuffer* tb) {
+    if constexpr (Instr::phases) phase_set(PH_LOCKING);
+    if constexpr (Instr::lockProfiling) {
+        st.lockAcquisitions++;
+        if (m.try_lock()) {
+            if constexpr (Instr::phases) phase_set(PH_HOLDING);
+            return;
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            TraceSpan locking(trace, tb, WAIT_MUTEX);
+            m.lock();
+        }
+        std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        st.lockContended++;
+        st.lockWaitNs += ns;
+        if (ns > st.maxLockWaitNs) st.maxLockWaitNs = ns;
+    } else {
+        TraceSpan locking(trace, tb, WAIT_MUTEX);
+        m.lock();
+    }
+    if constexpr (Instr::phases) phase_set(PH_HOLDING);
+}
+
+/**
+ * @brief The main execution loop for each Person thread.
+ *
+ * @param void
+ *
+ * @return void
+ *
+ * @details person waits for their assignment as a driver or passenger,
+ * performs the boat trip, updates the boat and personal state,
+ * and handles termination conditions. With timestamps compiled in and
+ * `boat->trace` set, every wait, seat, row and lock acquisition is recorded
+ * on this thread's track, and with `boat->lifecycle` set so are the crew's
+ * lifecycle timestamps. The seat, depart, arrive and reset USDT probes fire
+ * from here, and with phases compiled in the thread publishes what it is
+ * doing for the profiler. Stragglers and the boarding hooks need faults
+ * compiled in, the record hooks need capture.
+ */
+template <class Instr>
+void Person::run() {
+    PhaseThread<Instr::phases> profiled;
+    ChromeTrace* trace = Instr::timestamps ? boat->trace : nullptr;
+    LifecycleLog* lifecycle = Instr::timestamps ? boat->lifecycle : nullptr;
+    TraceBuffer* tb = trace ? trace->thread(std::string(isAdult ? "Adult " : "Child ") + std::to_string(id),
+                                            isAdult ? id : 1000000 + id) : nullptr;
+    std::ostream &out = *boat->out;
+    FlightRing* ring = Instr::recorder ? flight_ring(isAdult ? "Adult" : "Child", id) : nullptr;
+
+    lock_boat<Instr>(boat->mtx, stats, trace, tb);
+    std::unique_lock<Mutex> lk(boat->mtx, std::adopt_lock);
+    while (true) {
+        // exit condition: I'm on mainland and won't be needed anymore
+        if (boat->adultsOnIsland == 0 && boat->childrenOnIsland == 0 && position == MAINLAND) {
+            if (ring) ring->record(FL_EXIT, position);
+            return;
+        }
+
+        // Wait for assignment or final termination (when everyone is on mainland)
+        {
+            TraceSpan waiting(trace, tb, position == MAINLAND ? IDLE : BLOCKED_CV);
+            PhaseScope<Instr::phases> waitingPhase(PH_WAITING);
+            if constexpr (Instr::counters) stats.cvWaits++;
+            cv.wait(lk, [&, woken = false]() mutable {
+                bool ready = role != NONE || (boat->adultsOnIsland == 0 && boat->childrenOnIsland == 0 && position == MAINLAND);
+                if constexpr (Instr::counters) {
+                    if (woken) { stats.wakeups++; if (!ready) stats.spuriousWakeups++; }
+                    woken = true;
+                }
+                return ready;
+            });
+        }
+        // fault injection: stall like a descheduled thread before seating
+        if constexpr (Instr::faults) {
+            if (role != NONE && boat->straggles()) {
+                boat->mtx.unlock();
+                sync_sleep_for(std::chrono::duration_cast<std::chrono::microseconds>(
+                    boat->tripUnit * boat->straggleTime));
+                lock_boat<Instr>(boat->mtx, stats, trace, tb);
+                if (role == NONE) continue; // the controller gave the seat to someone else
+            }
+        }
+        if (lifecycle && role != NONE) lifecycle->mark(role == DRIVER ? LC_DRIVER_WOKEN : LC_PASSENGER_WOKEN);
+        if (ring) ring->record(FL_WOKEN, role, position);
+
+        // if assigned as driver
+        if (role == DRIVER) {
+            // print boarding
+            {
+                PhaseScope<Instr::phases> output(PH_OUTPUT);
+                out << (isAdult ? "Adult " : "Child ") << id
+                    << " got into the driver's seat of the boat." << std::endl;
+            }
+            seated = true;
+            boat->boardedCount++;
+            if constexpr (Instr::capture) { if (boat->record) boat->record->seat(true, isAdult ? id : -id); }
+            if constexpr (Instr::faults) { if (boat->boardingTimeout > 0) boat->boardedCv.notify_one(); }
+            if constexpr (Instr::probes) ISLAND_PROBE4(seat, id, isAdult, role, boat->location);
+            if (lifecycle) lifecycle->mark(LC_DRIVER_SEATED);
+            if (ring) ring->record(FL_SEATED, role, boat->location);
+
+            // wait until passenger (if any) is seated as well
+            TraceSpan waitingForCrew(trace, tb, SEATED);
+            while (boat->passenger != nullptr && !boat->passenger->seated) {
+                // release lock briefly to let passenger proceed
+                if constexpr (Instr::phases) phase_set(PH_SPINNING);
+                boat->mtx.unlock();
+                sync_yield();
+                if constexpr (Instr::counters) stats.spinYields++;
+                lock_boat<Instr>(boat->mtx, stats, nullptr, nullptr);
+            }
+            waitingForCrew.end();
+
+            // start trip: perform travel (release lock during sleep)
+            Loc start = boat->location;
+            Loc dest = (start == ISLAND ? MAINLAND : ISLAND);
+            boat->location = dest; // preflip
+
+            {
+                PhaseScope<Instr::phases> output(PH_OUTPUT);
+                out << "Boat is traveling from "
+                    << (start==ISLAND?"island":"mainland")
+                    << " to " << (dest==ISLAND?"island":"mainland") << std::endl;
+            }
+
+            int t = boat->tripTime();
+            if constexpr (Instr::capture) { if (boat->record) boat->record->travel(start, t); }
+            if constexpr (Instr::faults) {
+                if (boat->trackBoarding) {
+                    boat->boardingMs.push_back(std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - boat->assignedAt).count());
+                }
+            }
+            [[maybe_unused]] int passengerId = boat->passenger ? boat->passenger->id : 0;
+            int passengerCode = !boat->passenger ? 0 : boat->passenger->isAdult ? passengerId : -passengerId;
+            if constexpr (Instr::probes) ISLAND_PROBE5(depart, id, isAdult, passengerId, start, t);
+            if (lifecycle) lifecycle->mark(LC_DEPARTED);
+            if (ring) ring->record(FL_DEPART, passengerCode, t);
+            boat->mtx.unlock();
+            {
+                TraceSpan rowing(trace, tb, ROWING);
+                if constexpr (Instr::phases) phase_set(PH_TRAVEL);
+                sync_sleep_for(boat->tripUnit * t);
+            }
+            lock_boat<Instr>(boat->mtx, stats, trace, tb);
+            if constexpr (Instr::scheduling) boat->clock += t;
+            if constexpr (Instr::probes) ISLAND_PROBE5(arrive, id, isAdult, passengerId, start, t);
+            if (lifecycle) lifecycle->mark(LC_ARRIVED);
+            if (ring) ring->record(FL_ARRIVE, passengerCode, t);
+
+            // move riders and update counts
+            auto movePerson = [&](Person* p) {
+                if (!p) return;
+                if (start == ISLAND) {
+                    if (p->isAdult) boat->adultsOnIsland--;
+                    else boat->childrenOnIsland--;
+                    p->position = MAINLAND;
+                    if constexpr (Instr::scheduling) p->landedAt = boat->clock;
+                } else {
+                    if (p->isAdult) boat->adultsOnIsland++;
+                    else boat->childrenOnIsland++;
+                    p->position = ISLAND;
+                }
+            };
+
+            movePerson(this);
+            movePerson(boat->passenger);
+
+            if (start == ISLAND) boat->tripsToMain++; else boat->tripsToIsland++;
+            if constexpr (Instr::shadow) {
+                if (boat->shadow) {
+                    TripEvent e;
+                    e.trip = boat->tripsToMain + boat->tripsToIsland;
+                    e.driver = isAdult ? id : -id;
+                    e.passenger = passengerCode;
+                    e.driverRows = consecutiveRows;
+                    e.boarded = boat->boardedCount;
+                    e.adultsOnIsland = boat->adultsOnIsland;
+                    e.childrenOnIsland = boat->childrenOnIsland;
+                    e.from = static_cast<std::uint8_t>(start);
+                    boat->shadow->post(e);
+                }
+            }
+
+            // stats
+            if (boat->driver && boat->passenger) {
+                if (!boat->driver->isAdult && !boat->passenger->isAdult) boat->twokidBoats++;
+                else boat->kidAdultBoats++;
+            } else {
+                boat->soloBoats++;
+            }
+            if (boat->driver) {
+                if (boat->driver->isAdult) boat->adultDrivers++; else boat->childDrivers++;
+            }
+
+            // consecutive row handling
+            if (boat->driver) {
+                boat->driver->consecutiveRows++;
+                if (boat->driver->consecutiveRows >= MAX_CONSECUTIVE) boat->driver->needsBreak = true;
+            }
+            if (boat->passenger) {
+                boat->passenger->consecutiveRows = 0;
+                boat->passenger->needsBreak = false;
+            }
+
+            // clear boat pointers and boarded flags
+            Person* rider = boat->passenger;
+            boat->driver = nullptr;
+            boat->passenger = nullptr;
+            boat->boardedCount = 0;
+
+            // wake controller and any passenger waiting (trip done)
+            if (tb) tb->instant("tripDoneCv notified", trace->now());
+            if (lifecycle) lifecycle->mark(LC_NOTIFIED);
+            if (ring) ring->record(FL_NOTIFY);
+            if constexpr (Instr::counters) {
+                stats.notifies++;
+                stats.tripsDriven++;
+                boat->tripsCompleted.fetch_add(1, std::memory_order_relaxed);
+            }
+            boat->tripDoneCv.notify_all();
+
+            // reset my role/seated
+            if constexpr (Instr::probes) ISLAND_PROBE4(reset, id, isAdult, role, position);
+            if (ring) ring->record(FL_RESET, role, position);
+            role = NONE;
+            seated = false;
+            if constexpr (Instr::scheduling) { if (boat->dock) boat->dock->arrive(this); }
+            // the passenger is reset here as well, under the same lock, so the
+            // controller never sees a landed crew member still assigned
+            if (rider) {
+                rider->role = NONE;
+                rider->seated = false;
+                if constexpr (Instr::scheduling) { if (boat->dock) boat->dock->arrive(rider); }
+            }
+
+            // if I'm on mainland now and nobody needs me, I may exit in next loop
+            continue;
+        }
+
+        // if assigned passenger
+        if (role == PASSENGER) {
+            {
+                PhaseScope<Instr::phases> output(PH_OUTPUT);
+                out << (isAdult ? "Adult " : "Child ") << id
+                    << " got into the passenger seat of the boat." << std::endl;
+            }
+            seated = true;
+            boat->boardedCount++;
+            if constexpr (Instr::capture) { if (boat->record) boat->record->seat(false, isAdult ? id : -id); }
+            if constexpr (Instr::faults) { if (boat->boardingTimeout > 0) boat->boardedCv.notify_one(); }
+            if constexpr (Instr::probes) ISLAND_PROBE4(seat, id, isAdult, role, boat->location);
+            if (lifecycle) lifecycle->mark(LC_PASSENGER_SEATED);
+            if (ring) ring->record(FL_SEATED, role, boat->location);
+
+            // wait for trip completion (a wakeup before it is just spurious);
+            // the driver has reset my role by then
+            {
+                TraceSpan riding(trace, tb, SEATED);
+                PhaseScope<Instr::phases> waitingPhase(PH_WAITING);
+                if constexpr (Instr::counters) { stats.cvWaits++; stats.tripsRidden++; }
+                int trips = boat->tripsToMain + boat->tripsToIsland;
+                boat->tripDoneCv.wait(lk, [&]() { return boat->tripsToMain + boat->tripsToIsland != trips; });
+            }
+            if constexpr (Instr::probes) ISLAND_PROBE4(reset, id, isAdult, PASSENGER, position);
+            if (ring) ring->record(FL_RESET, PASSENGER, position);
+            continue;
+        }
+    }
+}
+
+/**
+ * @brief Find a person matching criteria.
+ *
+ * @param boat Boat whose selection policy is used.
+ * @param people Container of person pointers.
+ * @param wantAdult true for adult, false for child.
+ * @param where Location to search (ISLAND/MAINLAND).
+ * @param excludeNeedsBreak whether to exclude those needing a break.
+ *
+ * @return Person* or nullptr if none found.
+ *
+ * @details Picks a person matching the requested age and location, who is
+ *          not already assigned (`role == NONE`), according to
+ *          `boat.policy`. Every policy prefers persons below the
+ *          consecutive-row limit and then relaxes that preference, but
+ *          still honors `excludeNeedsBreak` if requested. With the fifo,
+ *          priority and edf policies the person is taken off the
+ *          boat's waiting line.
+ */
+template <class Instr>
+Person* find_person(Boat &boat, std::vector<std::unique_ptr<Person>> &people, bool wantAdult, Loc where, bool excludeNeedsBreak = true) {
+    if constexpr (Instr::scheduling) { if (boat.dock) return boat.dock->take(wantAdult, where, excludeNeedsBreak); }
+    return select_person(people, wantAdult, where, excludeNeedsBreak, boat.policy, boat.cursor);
+}
+
+/**
+ * @brief Find the second child of a two-child crew leaving the island.
+ *
+ * @param boat Boat whose selection policy is used.
+ * @param people Container of person pointers.
+ * @param first Child already chosen as driver.
+ *
+ * @return Person* or nullptr if none found.
+ *
+ * @details Any unassigned child on the island other than `first` qualifies.
+ */
+template <class Instr>
+Person* find_partner(Boat &boat, std::vector<std::unique_ptr<Person>> &people, Person* first) {
+    if constexpr (Instr::scheduling) { if (boat.dock) return boat.dock->take(false, ISLAND, false, /*preferRested=*/false); }
+    return select_partner(people, first, boat.policy, boat.cursor);
+}
+
+/**
+ * @brief Return people picked for a crew that could not be completed.
+ *
+ * @param boat Boat.
+ * @param p Person found by `find_person`, or nullptr.
+ *
+ * @return void
+ *
+ * @details Only the waiting-line policies remove people when they find
+ *          them; they go back into the line.
+ */
+template <class Instr>
+void put_back(Boat &boat, Person* p) {
+    if constexpr (Instr::scheduling) { if (boat.dock && p) boat.dock->arrive(p); }
+}
+
+/**
+ * @brief Wait for the assigned crew to sit down, replacing whoever is too slow.
+ *
+ * @param boat Boat with a crew assigned and `boardingTimeout > 0`.
+ * @param people Container of people.
+ * @param lk Lock on `boat.mtx`.
+ * @param finished Whether the crew's trip is already over.
+ *
+ * @return void
+ *
+ * @details Each time `boardingTimeout` passes without everyone seated, an
+ *          unseated crew member's seat goes to a free person of the same
+ *          age on the same shore (a driver only to someone who does not need
+ *          a break) and the straggler goes back to waiting. If nobody can
+ *          take the seat, the controller keeps waiting for the straggler.
+ */
+template <class Instr, class Pred>
+void board_crew(Boat &boat, std::vector<std::unique_ptr<Person>> &people, std::unique_lock<Mutex> &lk,
+                Pred finished) {
+    auto timeout = std::chrono::duration_cast<std::chrono::microseconds>(boat.tripUnit * boat.boardingTimeout);
+    auto seated = [&]() {
+        return finished() || (boat.driver->seated && (!boat.passenger || boat.passenger->seated));
+    };
+    while (!boat.boardedCv.wait_for(lk, timeout, seated)) {
+        for (Person** seat : {&boat.driver, &boat.passenger}) {
+            Person* late = *seat;
+            if (!late || late->seated) continue;
+            bool driving = seat == &boat.driver;
+            Person* sub = find_person<Instr>(boat, people, late->isAdult, late->position, /*excludeNeedsBreak=*/driving);
+            if (!sub) continue;
+            late->role = Person::NONE;
+            put_back<Instr>(boat, late);
+            sub->role = driving ? Person::DRIVER : Person::PASSENGER;
+            sub->seated = false;
+            *seat = sub;
+            boat.crewReplaced++;
+            sub->cv.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Controller loop that orchestrates deterministic ferrying of people.
+ *
+ * @param boat Reference to shared Boat.
+ * @param people Container of people.
+ *
+ * @return void
+ *
+ * @details Implementation: it repeatedly moves two children,
+ *          returns one, ships an adult with a child driving, and returns a
+ *          child, until all adults are moved; then it moves remaining
+ *          children, rowing the boat back first whenever the previous pair
+ *          left it on the mainland. The function holds the boat mutex while deciding and
+ *          notifying riders, and releases it while waiting for trip
+ *          completion. With `boat.trace` set it records its selection and
+ *          waiting spans plus markers for each assignment and completion.
+ *          The assign USDT probe fires for every crew it wakes. With
+ *          `boat.lifecycle` set it opens each trip's timeline and stamps
+ *          when it saw the trip finish. Everything it does between waits is
+ *          attributed to the "selecting crew" phase. With faults
+ *          compiled in and a boarding timeout, stragglers in a crew are
+ *          replaced by `board_crew`; with capture compiled in it takes the
+ *          checkpoints.
+ */
+template <class Instr>
+void controller_loop(Boat &boat, std::vector<std::unique_ptr<Person>> &people) {
+    PhaseThread<Instr::phases> profiled;
+    ChromeTrace* trace = Instr::timestamps ? boat.trace : nullptr;
+    LifecycleLog* lifecycle = Instr::timestamps ? boat.lifecycle : nullptr;
+    TraceBuffer* tb = trace ? trace->thread("controller", 0) : nullptr;
+    ThreadStats &stats = boat.controllerStats;
+    FlightRing* ring = Instr::recorder ? flight_ring("controller") : nullptr;
+    auto code = [](const Person* p) { return !p ? 0 : p->isAdult ? p->id : -p->id; };
+
+    lock_boat<Instr>(boat.mtx, stats, trace, tb);
+    std::unique_lock<Mutex> lk(boat.mtx, std::adopt_lock);
+    if constexpr (Instr::phases) phase_set(PH_SELECTING);
+
+    // wait for the crew just woken to finish its trip; when tracing, the time
+    // since the previous trip ended is recorded as crew selection
+    std::uint64_t selectStart = trace ? trace->now() : 0;
+    std::uint64_t lifecycleStart = lifecycle ? lifecycle->now() : 0;
+    auto wait_for_trip = [&]() {
+        if constexpr (Instr::probes) {
+            ISLAND_PROBE5(assign, boat.driver->id, boat.driver->isAdult,
+                          boat.passenger ? boat.passenger->id : 0,
+                          boat.passenger ? boat.passenger->isAdult : false, boat.location);
+        }
+        if (ring) ring->record(FL_ASSIGN, code(boat.driver), code(boat.passenger), boat.location);
+        if (lifecycle) {
+            lifecycle->begin_trip(lifecycleStart, boat.driver->id, boat.driver->isAdult,
+                                  boat.passenger ? boat.passenger->id : 0,
+                                  boat.passenger ? boat.passenger->isAdult : false);
+        }
+        if (tb) {
+            std::uint64_t now = trace->now();
+            tb->span(SELECTING, selectStart, now);
+            tb->instant("crew assigned", now);
+        }
+        if constexpr (Instr::faults) { if (boat.trackBoarding) boat.assignedAt = std::chrono::steady_clock::now(); }
+        {
+            TraceSpan waiting(trace, tb, BLOCKED_CV);
+            PhaseScope<Instr::phases> waitingPhase(PH_WAITING);
+            if constexpr (Instr::counters) { stats.notifies += boat.passenger ? 2 : 1; stats.cvWaits++; }
+            // the trip may end while the controller is still watching the boarding
+            int before = boat.tripsToMain + boat.tripsToIsland;
+            auto finished = [&]() { return boat.tripsToMain + boat.tripsToIsland != before; };
+            if constexpr (Instr::faults) { if (boat.boardingTimeout > 0) board_crew<Instr>(boat, people, lk, finished); }
+            boat.tripDoneCv.wait(lk, finished);
+        }
+        if (tb) {
+            selectStart = trace->now();
+            tb->instant("tripDoneCv observed", selectStart);
+        }
+        if (lifecycle) {
+            lifecycleStart = lifecycle->now();
+            lifecycle->mark(LC_OBSERVED, lifecycleStart);
+        }
+        if (ring) ring->record(FL_OBSERVE, boat.adultsOnIsland, boat.childrenOnIsland);
+    };
+
+    // checkpoints are taken before each crew is chosen, when nobody is assigned
+    auto save_point = [&]() {
+        if constexpr (Instr::capture) {
+            if (boat.checkpoint && boat.checkpoint->due(boat.tripsToMain + boat.tripsToIsland)) {
+                boat.checkpoint->save(boat, people);
+            }
+        }
+    };
+
+    // each step runs only at its stage, so a resumed run picks up where the
+    // checkpoint left off; a fresh run goes through all four in order
+    while (boat.stage != CrewStage::CHILDREN && (boat.stage != CrewStage::ADULT_PAIR || boat.adultsOnIsland > 0)) {
+        // 1) Two children go island -> mainland
+        if (boat.stage == CrewStage::ADULT_PAIR) {
+            save_point();
+            Person* c1 = find_person<Instr>(boat, people, false, ISLAND, /*excludeNeedsBreak=*/false);
+            Person* c2 = c1 ? find_partner<Instr>(boat, people, c1) : nullptr;
+            if (!c1 || !c2) { put_back<Instr>(boat, c1); break; }
+            boat.driver = c1; boat.passenger = c2;
+            c1->role = Person::DRIVER; c2->role = Person::PASSENGER; c1->seated = c2->seated = false;
+            c1->cv.notify_one(); c2->cv.notify_one();
+            wait_for_trip();
+            boat.stage = CrewStage::ADULT_RETURN;
+        }
+
+        // 2) One child returns mainland -> island
+        if (boat.stage == CrewStage::ADULT_RETURN) {
+            save_point();
+            Person* rc = find_person<Instr>(boat, people, false, MAINLAND, /*excludeNeedsBreak=*/false);
+            if (!rc) rc = find_person<Instr>(boat, people, true, MAINLAND, /*excludeNeedsBreak=*/false);
+            if (!rc) break;
+            boat.driver = rc; boat.passenger = nullptr; rc->role = Person::DRIVER; rc->seated = false; rc->cv.notify_one();
+            wait_for_trip();
+            boat.stage = CrewStage::ADULT_WITH_CHILD;
+        }
+
+        // 3) One adult + one child go island -> mainland (child drives)
+        if (boat.stage == CrewStage::ADULT_WITH_CHILD) {
+            save_point();
+            Person* adult = find_person<Instr>(boat, people, true, ISLAND, false);
+            Person* child = find_person<Instr>(boat, people, false, ISLAND, false);
+            if (!adult || !child) { put_back<Instr>(boat, adult); put_back<Instr>(boat, child); break; }
+            boat.driver = child; boat.passenger = adult; child->role = Person::DRIVER; adult->role = Person::PASSENGER;
+            child->seated = adult->seated = false; child->cv.notify_one(); adult->cv.notify_one();
+            wait_for_trip();
+            boat.stage = CrewStage::ADULT_RETURN_AGAIN;
+        }
+
+        // 4) One child returns mainland -> island (not needed once the island is empty;
+        //    everybody's thread has already exited at that point)
+        if (boat.stage == CrewStage::ADULT_RETURN_AGAIN) {
+            if (boat.adultsOnIsland == 0 && boat.childrenOnIsland == 0) break;
+            save_point();
+            Person* rc2 = find_person<Instr>(boat, people, false, MAINLAND, false);
+            if (!rc2) rc2 = find_person<Instr>(boat, people, true, MAINLAND, false);
+            if (!rc2) break;
+            boat.driver = rc2; boat.passenger = nullptr; rc2->role = Person::DRIVER; rc2->seated = false; rc2->cv.notify_one();
+            wait_for_trip();
+            boat.stage = CrewStage::ADULT_PAIR;
+        }
+    }
+    boat.stage = CrewStage::CHILDREN;
+
+    // Move remaining children in pairs (or solo)
+    while (boat.childrenOnIsland > 0) {
+        save_point();
+        if (boat.location == MAINLAND) {
+            // the last pair left the boat on the mainland, bring it back first
+            Person* rc = find_person<Instr>(boat, people, false, MAINLAND, false);
+            if (!rc) rc = find_person<Instr>(boat, people, true, MAINLAND, false);
+            if (!rc) break;
+            boat.driver = rc; boat.passenger = nullptr; rc->role = Person::DRIVER; rc->seated = false; rc->cv.notify_one();
+            wait_for_trip();
+        } else if (boat.childrenOnIsland >= 2) {
+            // the row limit is a preference: when every child left needs a
+            // break, one of them rows anyway rather than stranding the rest
+            Person* c1 = find_person<Instr>(boat, people, false, ISLAND, false);
+            Person* c2 = c1 ? find_partner<Instr>(boat, people, c1) : nullptr;
+            if (c1 && c2) {
+                boat.driver = c1; boat.passenger = c2;
+                c1->role = Person::DRIVER; c2->role = Person::PASSENGER;
+                c1->seated = c2->seated = false;
+                c1->cv.notify_one(); c2->cv.notify_one();
+                wait_for_trip();
+            } else {
+                put_back<Instr>(boat, c1);
+                break;
+            }
+        } else {
+            Person* c = find_person<Instr>(boat, people, false, ISLAND, false);
+            if (c) {
+                boat.driver = c; c->role = Person::DRIVER; c->seated=false; c->cv.notify_one();
+                wait_for_trip();
+            } else break;
+        }
+    }
+
+    // one of the breaks above gave up with people left behind; their
+    // threads never exit, so leave the evidence before anything hangs
+    if (ring && (boat.adultsOnIsland > 0 || boat.childrenOnIsland > 0)) {
+        ring->record(FL_STALL, boat.adultsOnIsland, boat.childrenOnIsland);
+        flight_dump("controller stopped with people on the island");
+    }
+
+    // wake anyone still blocked to let threads exit
+    for (auto &p : people) p->cv.notify_one();
+
+    // unlock while joining threads
+    lk.unlock();
+}
+
+std::vector<std::unique_ptr<Person>> init_people(Boat* boat, int A, int C, const Triage &triage = {});
+void join_threads(std::vector<std::unique_ptr<Person>> &people);
+void print_summary(Boat &boat);
+void print_counters(const Boat &boat, const std::vector<std::unique_ptr<Person>> &people, std::ostream &os);
+void print_state(const Boat &boat, const std::vector<std::unique_ptr<Person>> &people, std::ostream &os);
+void print_boarding(const Boat &boat, double makespan, std::ostream &os);
+
+/**
+ * @brief Start threads for all people in container.
+ *
+ * @param people Container of people whose threads will be started.
+ *
+ * @return void
+ *
+ * @details Creates a `Thread` (`sync.h`) for each `Person` that runs
+ *          `Person::run<Instr>()` and stores it in the person's `th` member.
+ */
+template <class Instr>
+void start_threads(std::vector<std::unique_ptr<Person>> &people) {
+    for (auto &p : people) p->th = Thread(&Person::run<Instr>, p.get());
+}
+
+/**
+ * @brief Run one threaded simulation to completion.
+ *
+ * @param boat Boat, already set up with the island counts and options.
+ * @param people People created by `init_people` for this boat.
+ *
+ * @return void
+ *
+ * @details With `boat.watchdog` set (and counters compiled in) a
+ *          `Watchdog` runs for the whole simulation.
+ */
+template <class Instr>
+void run_simulation(Boat &boat, std::vector<std::unique_ptr<Person>> &people) {
+    if constexpr (Instr::recorder) flight_reset();
+    std::unique_ptr<Watchdog> watchdog;
+    if (Instr::counters && boat.watchdog.count() > 0)
+        watchdog = std::make_unique<Watchdog>(boat, people, boat.watchdog, boat.watchdogAbort);
+    start_threads<Instr>(people);
+    controller_loop<Instr>(boat, people);
+    join_threads(people);
+}
+
+#endif
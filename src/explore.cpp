@@ -0,0 +1,257 @@
+/**
+ * @file src/explore.cpp
+ *
+ * @brief Systematic exploration of the engine's thread interleavings.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Built with `-DISLAND_EXPLORE`, so the engine's mutex, condition variables,
+ * yields, sleeps and threads are the instrumented ones of `sync.h`. Each
+ * schedule runs the unmodified `controller_loop` and `Person::run` with
+ * zero-length trips under one seed of the controlled scheduler, then checks
+ * the outcome:
+ *
+ * - the schedule completed (no deadlock, lost wakeup or livelock);
+ * - everybody ended on the mainland;
+ * - the summary counters equal those of the sequential `Ferry` model, which
+ *   makes the same decisions without threads (skipped with a boarding
+ *   timeout, since replacements depend on the interleaving).
+ *
+ * The engine is instantiated with faults compiled in, so `--boarding-timeout`
+ * reaches `board_crew`; the summary then counts the replaced crew members.
+ *
+ * The first failing schedule is reported with its seed; rerunning with that
+ * seed and `--schedules 1 --verbose` replays it decision by decision.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "model.h"
+
+// the engine as in the lean build, plus boarding timeouts (`board_crew`) and
+// the waiting lines of the fifo, priority and edf policies
+using ExploreInstrumentation = Instrumentation<false, false, false, false, false, false, true, false, false, true>;
+
+/**
+ * @struct ExploreConfig
+ *
+ * @brief Command line of `bin/island-explore`.
+ */
+struct ExploreConfig {
+    int adults = 0, children = 0;
+    long schedules = 1000;
+    Policy policy = Policy::FIRST_FIT;
+    double boardingTimeout = 0;
+    ExploreOptions opts;
+};
+
+/**
+ * @brief Run the engine once under the controlled scheduler and check the result.
+ *
+ * @param cfg Configuration.
+ * @param seed Schedule seed (also seeds the trip times).
+ * @param why Output: what went wrong, if anything.
+ * @param result Output: scheduler statistics of the schedule.
+ * @param replaced Output: crew members replaced by the boarding timeout.
+ *
+ * @return bool true if the schedule passed every check.
+ */
+static bool run_schedule(const ExploreConfig &cfg, std::uint64_t seed, std::string &why, ExploreResult &result,
+                         long &replaced) {
+    ExploreOptions opts = cfg.opts;
+    opts.seed = seed;
+    std::ostream discard(nullptr);
+    Boat boat;
+    boat.adultsOnIsland = cfg.adults;
+    boat.childrenOnIsland = cfg.children;
+    boat.out = &discard;
+    boat.tripUnit = std::chrono::microseconds(0);
+    boat.rng.seed(static_cast<std::mt19937::result_type>(seed));
+    boat.faultRng.seed(static_cast<std::mt19937::result_type>(seed ^ 0x5DEECE66D));
+    boat.policy = cfg.policy;
+    boat.boardingTimeout = cfg.boardingTimeout;
+    auto people = init_people(&boat, cfg.adults, cfg.children);
+
+    explore_begin(opts);
+    try {
+        start_threads<ExploreInstrumentation>(people);
+        // managed threads only run once scheduled, so they can be named now
+        for (std::size_t i = 0; i < people.size(); ++i) {
+            explore_name(static_cast<int>(i) + 1, std::string(people[i]->isAdult ? "Adult " : "Child ") + std::to_string(people[i]->id));
+        }
+        controller_loop<ExploreInstrumentation>(boat, people);
+    } catch (const ScheduleAborted &) {
+    }
+    join_threads(people);
+    result = explore_end();
+    replaced = boat.crewReplaced;
+
+    std::ostringstream os;
+    if (result.outcome != ExploreResult::COMPLETED) {
+        os << (result.outcome == ExploreResult::DEADLOCK ? "deadlock" : "livelock")
+           << " after " << result.steps << " steps" << std::endl << result.blocked;
+        print_state(boat, people, os);
+        why = os.str();
+        return false;
+    }
+
+    Ferry model(cfg.adults, cfg.children, cfg.policy);
+    Trip trip;
+    while (model.plan(trip)) model.finish(trip, 0, 0);
+    bool landed = true;
+    for (auto &p : people) landed = landed && p->position == MAINLAND;
+    if (!landed) {
+        os << "completed with people left on the island" << std::endl;
+    } else if (cfg.boardingTimeout <= 0 &&
+               (boat.tripsToMain != model.tripsToMain || boat.tripsToIsland != model.tripsToIsland ||
+                boat.twokidBoats != model.twokidBoats || boat.kidAdultBoats != model.kidAdultBoats ||
+                boat.soloBoats != model.soloBoats || boat.adultDrivers != model.adultDrivers ||
+                boat.childDrivers != model.childDrivers)) {
+        os << "counters differ from the model: trips " << boat.tripsToMain << "/" << boat.tripsToIsland
+           << " vs " << model.tripsToMain << "/" << model.tripsToIsland << ", boats "
+           << boat.twokidBoats << "/" << boat.kidAdultBoats << "/" << boat.soloBoats << " vs "
+           << model.twokidBoats << "/" << model.kidAdultBoats << "/" << model.soloBoats << std::endl;
+    } else {
+        return true;
+    }
+    print_state(boat, people, os);
+    why = os.str();
+    return false;
+}
+
+/**
+ * @brief Print the command line help.
+ *
+ * @param void
+ *
+ * @return void
+ */
+static void usage() {
+    std::cerr << "usage: ./bin/island-explore <adults> <children> [options]" << std::endl
+              << "  --schedules N          schedules to run (default 1000)" << std::endl
+              << "  --seed S               seed of the first schedule; schedule i uses S + i" << std::endl
+              << "  --strategy NAME        pct (default), random or preempt" << std::endl
+              << "  --depth D              pct: bug depth, D - 1 priority change points (default 3)" << std::endl
+              << "  --bound B              preempt: preemptions per schedule (default 2)" << std::endl
+              << "  --max-steps N          report a livelock after N scheduling points (default 200000)" << std::endl
+              << "  --spurious             let condition variable waits wake up spuriously" << std::endl
+              << "  --policy P             crew selection policy (default first-fit)" << std::endl
+              << "  --boarding-timeout S   replace crew members who do not seat in time" << std::endl
+              << "  --verbose              print the scheduling decisions of a failing schedule" << std::endl;
+}
+
+/**
+ * @brief Entry point: `./bin/island-explore <adults> <children> [options]`.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ *
+ * @return int 0 if every schedule passed, 1 on bad arguments or a failing schedule.
+ */
+int main(int argc, char** argv) {
+    ExploreConfig cfg;
+    std::uint64_t seed = 1;
+    std::vector<std::string> positional;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool more = i + 1 < argc;
+            if (arg == "--schedules" && more) cfg.schedules = std::stol(argv[++i]);
+            else if (arg == "--seed" && more) seed = std::stoull(argv[++i]);
+            else if (arg == "--strategy" && more) {
+                std::string s = argv[++i];
+                if (s == "pct") cfg.opts.strategy = ExploreOptions::PCT;
+                else if (s == "random") cfg.opts.strategy = ExploreOptions::RANDOM;
+                else if (s == "preempt") cfg.opts.strategy = ExploreOptions::PREEMPT;
+                else throw 0;
+            }
+            else if (arg == "--depth" && more) cfg.opts.depth = std::stoi(argv[++i]);
+            else if (arg == "--bound" && more) cfg.opts.bound = std::stoi(argv[++i]);
+            else if (arg == "--max-steps" && more) cfg.opts.maxSteps = std::stol(argv[++i]);
+            else if (arg == "--spurious") cfg.opts.spurious = true;
+            else if (arg == "--policy" && more) { if (!parse_policy(argv[++i], cfg.policy)) throw 0; }
+            else if (arg == "--boarding-timeout" && more) cfg.boardingTimeout = std::stod(argv[++i]);
+            else if (arg == "--verbose") cfg.opts.verbose = true;
+            else positional.push_back(arg);
+        }
+        if (positional.size() != 2) throw 0;
+        cfg.adults = std::stoi(positional[0]);
+        cfg.children = std::stoi(positional[1]);
+    } catch (...) {
+        usage();
+        return 1;
+    }
+    if (cfg.adults < 0 || cfg.children < 0 || cfg.schedules <= 0 || cfg.opts.depth < 1 ||
+        cfg.opts.bound < 0 || cfg.opts.maxSteps <= 0 || cfg.boardingTimeout < 0) {
+        std::cerr << "need adults, children >= 0, schedules > 0, depth >= 1, bound >= 0 and max-steps > 0" << std::endl;
+        return 1;
+    }
+
+    static const char* strategies[] = {"random", "pct", "preempt"};
+    std::cout << "Exploring " << cfg.adults << " adults, " << cfg.children << " children, policy "
+              << policy_name(cfg.policy) << ", strategy " << strategies[cfg.opts.strategy] << std::endl;
+
+    // pct spreads its change points over the length of a typical schedule;
+    // measure one (same for every run with this configuration, so seeds replay)
+    {
+        ExploreConfig calibrate = cfg;
+        calibrate.opts.strategy = ExploreOptions::RANDOM;
+        std::string why;
+        ExploreResult r;
+        long replaced = 0;
+        if (run_schedule(calibrate, 0, why, r, replaced)) cfg.opts.stepsHint = r.steps;
+    }
+
+    long steps = 0, switches = 0, preemptions = 0, passed = 0, replacements = 0, replacing = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < cfg.schedules; ++i) {
+        std::uint64_t s = seed + static_cast<std::uint64_t>(i);
+        std::string why;
+        ExploreResult r;
+        long replaced = 0;
+        bool ok = run_schedule(cfg, s, why, r, replaced);
+        replacements += replaced;
+        if (replaced) replacing++;
+        steps += r.steps;
+        switches += r.switches;
+        preemptions += r.preemptions;
+        if (ok) { passed++; continue; }
+
+        std::cout << "Schedule " << i << " (seed " << s << ") failed: " << why;
+        if (cfg.opts.verbose) {
+            // a livelock log is long; the end shows the loop
+            std::size_t from = r.log.size(), lines = 0;
+            while (from > 0 && lines <= 200) if (r.log[--from] == '\n') lines++;
+            if (lines > 200) from++;
+            std::cout << "Scheduling decisions (step, thread: operation -> next thread)"
+                      << (from > 0 ? ", last 200:" : ":") << std::endl << r.log.substr(from);
+        }
+        std::cout << "Replay: ./bin/island-explore " << cfg.adults << " " << cfg.children
+                  << " --schedules 1 --seed " << s << " --strategy " << strategies[cfg.opts.strategy]
+                  << " --depth " << cfg.opts.depth << " --bound " << cfg.opts.bound
+                  << " --policy " << policy_name(cfg.policy) << (cfg.opts.spurious ? " --spurious" : "");
+        if (cfg.boardingTimeout > 0) std::cout << " --boarding-timeout " << cfg.boardingTimeout;
+        std::cout << " --verbose" << std::endl;
+        break;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    long run = passed + (passed < cfg.schedules ? 1 : 0);
+    std::cout << "Schedules: " << passed << " passed of " << run << " run, " << static_cast<long>(run / secs)
+              << " per second" << std::endl;
+    std::cout << "Per schedule: " << steps / run << " scheduling points, " << switches / run
+              << " context switches, " << static_cast<double>(preemptions) / run << " preemptions" << std::endl;
+    if (cfg.boardingTimeout > 0) {
+        std::cout << "Boarding timeouts: " << replacements << " crew members replaced in " << replacing
+                  << " schedules" << std::endl;
+    }
+    return passed == run ? 0 : 1;
+}
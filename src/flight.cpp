@@ -0,0 +1,267 @@
+/**
+ * @file src/flight.cpp
+ *
+ * @brief Always-on flight recorder: ring registry, signal hooks and the dump.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "flight.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <unistd.h>
+
+// registry of rings; slots are allocated once and reused by later runs
+static const std::size_t MAX_RINGS = 4096;
+static FlightRing* rings[MAX_RINGS];
+static std::atomic<std::size_t> ringCount{0};
+
+// tick rate calibration: counter and clock at install time
+static std::uint64_t baseTicks = 0, baseNs = 0;
+
+static std::atomic<bool> fatalDumped{false};
+static std::atomic<bool> dumping{false}; // the merge state below is shared
+
+static std::uint64_t clock_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @struct Writer
+ *
+ * @brief Fixed buffer flushed with write(2); no allocation, no stdio.
+ */
+struct Writer {
+    char buf[4096];
+    std::size_t n = 0;
+
+    void flush() {
+        std::size_t off = 0;
+        while (off < n) {
+            ssize_t w = ::write(2, buf + off, n - off);
+            if (w <= 0) break;
+            off += static_cast<std::size_t>(w);
+        }
+        n = 0;
+    }
+    void put(const char* s) {
+        while (*s) {
+            if (n == sizeof buf) flush();
+            buf[n++] = *s++;
+        }
+    }
+    void num(std::uint64_t v, int width = 0) {
+        char tmp[24];
+        int len = 0;
+        do { tmp[len++] = static_cast<char>('0' + v % 10); v /= 10; } while (v);
+        for (int i = len; i < width; ++i) put(" ");
+        char out[24];
+        for (int i = 0; i < len; ++i) out[i] = tmp[len - 1 - i];
+        out[len] = '\0';
+        put(out);
+    }
+    void person(int code) {
+        if (code == 0) { put("-"); return; }
+        put(code > 0 ? "A" : "C");
+        num(static_cast<std::uint64_t>(code > 0 ? code : -code));
+    }
+    void pad(std::size_t from, std::size_t width) {
+        while (n - from < width) put(" ");
+    }
+};
+
+static const char* role_name(int r) { return r == 1 ? "driver" : r == 2 ? "passenger" : "none"; }
+static const char* loc_name(int l) { return l == 0 ? "island" : "mainland"; }
+
+/**
+ * @brief Append the text of one event.
+ *
+ * @param w Output.
+ * @param e Event.
+ *
+ * @return void
+ */
+static void describe(Writer &w, const FlightEvent &e) {
+    switch (e.kind) {
+    case FL_WOKEN: w.put("woken as "); w.put(role_name(e.a)); w.put(" on the "); w.put(loc_name(e.b)); break;
+    case FL_SEATED: w.put("seated as "); w.put(role_name(e.a)); w.put(", boat at the "); w.put(loc_name(e.b)); break;
+    case FL_DEPART: w.put("departed with passenger "); w.person(e.a); w.put(", trip "); w.num(e.b); break;
+    case FL_ARRIVE: w.put("arrived with passenger "); w.person(e.a); w.put(", trip "); w.num(e.b); break;
+    case FL_NOTIFY: w.put("notified tripDoneCv"); break;
+    case FL_RESET: w.put("released ("); w.put(role_name(e.a)); w.put("), now on the "); w.put(loc_name(e.b)); break;
+    case FL_EXIT: w.put("exited on the "); w.put(loc_name(e.a)); break;
+    case FL_ASSIGN:
+        w.put("assigned driver "); w.person(e.a); w.put(" passenger "); w.person(e.b);
+        w.put(" from the "); w.put(loc_name(e.c));
+        break;
+    case FL_OBSERVE:
+        w.put("observed trip end, island has "); w.num(e.a); w.put(" adults "); w.num(e.b); w.put(" children");
+        break;
+    case FL_STALL:
+        w.put("STOPPED with "); w.num(e.a); w.put(" adults "); w.num(e.b); w.put(" children on the island");
+        break;
+    default: w.put("?"); break;
+    }
+}
+
+/**
+ * @brief Signal handler: dump, then either continue or die as before.
+ *
+ * @param sig Signal number.
+ *
+ * @return void
+ */
+static void on_signal(int sig) {
+    if (sig == SIGUSR1) {
+        flight_dump("SIGUSR1");
+        return;
+    }
+    if (!fatalDumped.exchange(true)) {
+        const char* name = sig == SIGSEGV ? "SIGSEGV" : sig == SIGABRT ? "SIGABRT" : sig == SIGBUS ? "SIGBUS"
+                         : sig == SIGFPE ? "SIGFPE" : sig == SIGILL ? "SIGILL" : sig == SIGINT ? "SIGINT"
+                         : sig == SIGTERM ? "SIGTERM" : "signal";
+        flight_dump(name);
+    }
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+/**
+ * @brief `std::terminate` handler: dump once, then abort.
+ *
+ * @return void
+ */
+static void on_terminate() {
+    if (!fatalDumped.exchange(true)) flight_dump("std::terminate");
+    std::signal(SIGABRT, SIG_DFL);
+    std::abort();
+}
+
+/**
+ * @brief Calibrate the clock and hook signals and `std::terminate`.
+ *
+ * @return void
+ *
+ * @details SIGUSR1 dumps and lets the run continue; SIGSEGV, SIGBUS, SIGFPE,
+ *          SIGILL, SIGABRT, SIGINT and SIGTERM dump once and then take their
+ *          default action.
+ */
+void flight_install() {
+    baseTicks = flight_ticks();
+    baseNs = clock_ns();
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof sa);
+    sa.sa_handler = on_signal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    for (int sig : {SIGUSR1, SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, SIGINT, SIGTERM})
+        sigaction(sig, &sa, nullptr);
+    std::set_terminate(on_terminate);
+}
+
+/**
+ * @brief Forget the rings of the previous run so their slots are reused.
+ *
+ * @return void
+ *
+ * @details Call only while no simulation thread is running.
+ */
+void flight_reset() {
+    ringCount.store(0, std::memory_order_release);
+}
+
+/**
+ * @brief Register the calling thread and return its ring.
+ *
+ * @param prefix Thread name, e.g. "Adult" or "controller".
+ * @param id Number appended to the name, or negative for none.
+ *
+ * @return FlightRing* The thread's ring, or nullptr if the registry is full.
+ */
+FlightRing* flight_ring(const char* prefix, int id) {
+    std::size_t slot = ringCount.load(std::memory_order_acquire);
+    do {
+        if (slot >= MAX_RINGS) return nullptr;
+    } while (!ringCount.compare_exchange_weak(slot, slot + 1));
+    if (!rings[slot]) rings[slot] = new FlightRing();
+    FlightRing* r = rings[slot];
+    r->head.store(0, std::memory_order_relaxed);
+
+    Writer w; // only used as a formatter here
+    w.put(prefix);
+    if (id >= 0) { w.put(" "); w.num(static_cast<std::uint64_t>(id)); }
+    std::size_t len = w.n < sizeof r->name - 1 ? w.n : sizeof r->name - 1;
+    std::memcpy(r->name, w.buf, len);
+    r->name[len] = '\0';
+    return r;
+}
+
+/**
+ * @brief Write every registered thread's recent events to stderr.
+ *
+ * @param reason Why the dump happened (printed in the header).
+ *
+ * @return void
+ *
+ * @details Async-signal-safe. Events are merged across threads in time order
+ *          and stamped relative to the dump. Rings still being written may
+ *          show a torn last event, which is acceptable for post-mortem use.
+ */
+void flight_dump(const char* reason) {
+    static std::uint64_t cursor[MAX_RINGS], end[MAX_RINGS];
+    if (dumping.exchange(true)) return; // another dump is in progress
+    std::size_t count = ringCount.load(std::memory_order_acquire);
+    if (count > MAX_RINGS) count = MAX_RINGS;
+
+    std::uint64_t nowTicks = flight_ticks(), nowNs = clock_ns();
+    double nsPerTick = nowTicks > baseTicks && nowNs > baseNs
+                     ? double(nowNs - baseNs) / double(nowTicks - baseTicks) : 1.0;
+
+    Writer w;
+    w.put("=== flight recorder: "); w.put(reason); w.put(" ===\n");
+    for (std::size_t i = 0; i < count; ++i) {
+        end[i] = rings[i] ? rings[i]->head.load(std::memory_order_acquire) : 0; // slot still being set up
+        cursor[i] = end[i] > FLIGHT_RING_SIZE ? end[i] - FLIGHT_RING_SIZE : 0;
+    }
+
+    while (true) {
+        // next event in time order across all rings
+        std::size_t best = count;
+        std::uint64_t bestTicks = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (cursor[i] >= end[i]) continue;
+            std::uint64_t t = rings[i]->events[cursor[i] & (FLIGHT_RING_SIZE - 1)].ticks;
+            if (best == count || t < bestTicks) { best = i; bestTicks = t; }
+        }
+        if (best == count) break;
+        const FlightEvent &e = rings[best]->events[cursor[best]++ & (FLIGHT_RING_SIZE - 1)];
+
+        std::uint64_t agoUs = e.ticks < nowTicks ? static_cast<std::uint64_t>((nowTicks - e.ticks) * nsPerTick / 1000) : 0;
+        std::uint64_t ms = agoUs / 1000;
+        int digits = 1;
+        for (std::uint64_t v = ms; v >= 10; v /= 10) digits++;
+        w.put("  ");
+        for (int i = digits; i < 6; ++i) w.put(" ");
+        w.put("-");
+        w.num(ms); w.put(".");
+        std::uint64_t frac = agoUs % 1000;
+        if (frac < 100) w.put("0");
+        if (frac < 10) w.put("0");
+        w.num(frac); w.put(" ms  ");
+        std::size_t col = w.n;
+        w.put(rings[best]->name);
+        w.pad(col, 14);
+        describe(w, e);
+        w.put("\n");
+    }
+    w.put("=== end of flight recorder ===\n");
+    w.flush();
+    dumping.store(false);
+}
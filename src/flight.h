@@ -0,0 +1,110 @@
+/**
+ * @file src/flight.h
+ *
+ * @brief Always-on flight recorder: the last lifecycle events of every thread.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Each simulation thread owns a fixed ring of the last `FLIGHT_RING_SIZE`
+ * events. Recording is a timestamp counter read and a few stores into the
+ * thread's own ring, with no locks or allocation, so it stays enabled in
+ * every instrumented build. The rings are only read when something went
+ * wrong: `flight_dump` merges them in time order and writes them to stderr
+ * using only async-signal-safe calls, so it also works from a signal
+ * handler. `flight_install` arranges dumps on SIGUSR1 (the run continues),
+ * on fatal and termination signals, and on `std::terminate`.
+ */
+
+#ifndef FLIGHT_H
+#define FLIGHT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @enum FlightKind
+ *
+ * @brief Recorded events. Person codes are `+id` for adults and `-id` for
+ *        children; locations are `Loc` values.
+ *
+ * - FL_WOKEN(role, position): a person returned from its assignment wait.
+ * - FL_SEATED(role, boat location)
+ * - FL_DEPART(passenger, trip units) / FL_ARRIVE(passenger, trip units)
+ * - FL_NOTIFY: driver signalled trip completion.
+ * - FL_RESET(role, position): released after the trip.
+ * - FL_EXIT(position): the thread is leaving.
+ * - FL_ASSIGN(driver, passenger, boat location): controller woke a crew.
+ * - FL_OBSERVE(adults, children on the island): controller saw a trip end.
+ * - FL_STALL(adults, children on the island): controller gave up early.
+ */
+enum FlightKind : std::uint16_t {
+    FL_WOKEN, FL_SEATED, FL_DEPART, FL_ARRIVE, FL_NOTIFY, FL_RESET, FL_EXIT,
+    FL_ASSIGN, FL_OBSERVE, FL_STALL,
+};
+
+/**
+ * @struct FlightEvent
+ *
+ * @brief One recorded event (24 bytes).
+ */
+struct FlightEvent {
+    std::uint64_t ticks;
+    std::uint32_t kind;
+    std::int32_t a, b, c;
+};
+
+// events kept per thread (power of two)
+static const std::size_t FLIGHT_RING_SIZE = 256;
+
+/**
+ * @brief Current timestamp counter value.
+ *
+ * @return std::uint64_t TSC ticks on x86, nanoseconds elsewhere.
+ */
+inline std::uint64_t flight_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+/**
+ * @struct FlightRing
+ *
+ * @brief Ring of one thread's last events; only that thread writes it.
+ */
+struct FlightRing {
+    char name[24] = {};
+    std::atomic<std::uint64_t> head{0}; // events ever recorded
+    FlightEvent events[FLIGHT_RING_SIZE];
+
+    void record(FlightKind kind, int a = 0, int b = 0, int c = 0) {
+        std::uint64_t h = head.load(std::memory_order_relaxed);
+        FlightEvent &e = events[h & (FLIGHT_RING_SIZE - 1)];
+        e.ticks = flight_ticks();
+        e.kind = kind;
+        e.a = a;
+        e.b = b;
+        e.c = c;
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+void flight_install();
+void flight_reset();
+FlightRing* flight_ring(const char* prefix, int id = -1);
+void flight_dump(const char* reason);
+
+#endif
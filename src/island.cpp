@@ -16,254 +16,288 @@
  * and the maximum consecutive rowing limit for each person.
  */
 
+#include <chrono>
 #include <iostream>
-#include <thread>
 #include <vector>
 #include <random>
-#include <chrono>
-#include <mutex>
-#include <condition_variable>
 #include <memory>
-
-// Global boat state of either ISLAND or MAINLAND
-enum Loc { ISLAND, MAINLAND };
-
-// maximum consecutive times a person may drive the boat
-static const int MAX_CONSECUTIVE = 4; 
-
-// forward declaration of Boat structure
-struct Boat;
+#include <string>
+#include <cstdint>
+
+#include "aggregate.h"
+#include "checkpoint.h"
+#include "engine.h"
+#include "opensys.h"
+#include "parallel.h"
+#include "pdes.h"
+#include "reactor.h"
+#include "record.h"
+#include "replicas.h"
+#include "resources.h"
+
+// ISLAND_INSTRUMENTATION=0 builds the engine without any instrumentation
+#ifndef ISLAND_INSTRUMENTATION
+#define ISLAND_INSTRUMENTATION 1
+#endif
+
+#if ISLAND_INSTRUMENTATION
+using Engine = FullInstrumentation;
+#else
+using Engine = NoInstrumentation;
+#endif
 
 /**
- * @struct Person
- * 
- * @brief Represents a person (adult or child) trying to cross between island and mainland.
- * 
- * The struct contains the person's ID, type (adult/child), current position,
- * consecutive rowing count, role in the boat (driver/passenger/none), and
- * threading constructs for synchronization.
+ * @struct Options
+ *
+ * @brief Command line settings.
+ *
+ * `replicas > 0` selects Monte Carlo mode, which runs the sequential model in
+ * virtual time instead of the threaded simulation. A non-empty `compare`
+ * list turns it into a paired comparison of those policies. `aggregate` and
+ * `capacityTable` switch replicas to the vectorized aggregated simulator.
+ * `fleet > 0` runs that many independent boats in real time on `reactors`
+ * epoll reactor threads instead of one boat with a thread per person.
+ * `islands > 0` runs that many islands sharing `docks` mainland docks in virtual
+ * time, sequentially (`lps == 0`) or as a parallel discrete-event simulation.
+ * `arrivalRate > 0` runs an open system in virtual time, where people keep
+ * arriving at a shore of `shoreCapacity` places guarded by `admission`.
+ * A non-empty `replay` replays a file written by `record` instead of
+ * running anything. A non-empty `checkpoint` snapshots the threaded run
+ * every `checkpointEvery` trips; a non-empty `resume` continues the run
+ * saved in that file.
  */
-struct Person {
-    int id;
-    bool isAdult;
-    Loc position = ISLAND;
-    int consecutiveRows = 0; // how many times they've rowed in a row
-
-    // assignment state (protected by boat->mtx)
-    enum Role { NONE, DRIVER, PASSENGER } role = NONE;
-    bool seated = false;
-    bool needsBreak = false; // true when reached MAX_CONSECUTIVE and needs a break
-
-    std::condition_variable cv;
-    std::thread th;
-
-    Boat* boat = nullptr;
-
-    void run();
+struct Options {
+    int adults = 0;
+    int children = 0;
+    bool haveSeed = false;
+    std::uint64_t seed = 0;
+    long replicas = 0;
+    double ciWidth = 0;
+    long maxReplicas = 1000000;
+    Policy policy = Policy::FIRST_FIT;
+    std::vector<Policy> compare;
+    bool aggregate = false;
+    bool capacityTable = false;
+    std::string chromeTrace; // output file, empty = no tracing
+    bool lifecycle = false;
+    std::string eventLog; // event trace for bin/critpath, empty = none
+    bool counters = false;
+    bool shadow = false; // validate every trip on a separate thread
+    bool profile = false;
+    double timeScale = 1.0; // trip-time multiplier for the threaded run
+    double watchdog = 0;    // seconds without progress before reporting, 0 = off
+    bool watchdogAbort = false;
+    int fleet = 0;
+    unsigned reactors = 1;
+    int islands = 0;
+    int berths = 0; // 0 = one per eight islands
+    int docks = 0;  // 0 = one per eight berths
+    long lps = -1;  // -1 = one per hardware thread, 0 = sequential
+    double arrivalRate = 0;      // arrivals per second, 0 = closed system
+    double arrivalWindow = 3600; // seconds of arrivals
+    long shoreCapacity = 0;      // 0 = unbounded
+    Admission admission = Admission::REJECT;
+    int priorityClasses = 1;
+    double deadline = 0; // class-0 deadline in seconds, 0 = none
+    double straggle = 0;        // chance a woken crew member stalls
+    double straggleTime = 5;    // trip-time seconds a straggler stalls
+    double boardingTimeout = 0; // trip-time seconds before replacing a straggler, 0 = off
+    bool rusage = false;
+    std::string rusageJson; // resource usage as JSON, empty = none
+    std::string record;     // record of the threaded run, empty = none
+    std::string replay;     // record to replay, empty = run normally
+    std::string checkpoint; // snapshot file of the threaded run, empty = none
+    long checkpointEvery = 100;
+    std::string resume;     // snapshot file to resume from, empty = start afresh
+    int flags = 0;          // options given, for --replay and --resume
 };
 
 /**
- * @struct Boat
- * 
- * @brief Represents the state of the boat and manages synchronization between persons.
- * 
- * The struct contains mutexes and condition variables for thread synchronization,
- * the current location of the boat, counts of adults and children on the island,
- * pointers to the current driver and passenger, and various statistics.
+ * @brief Print the command line usage.
+ *
+ * @param void
+ *
+ * @return void
  */
-struct Boat {
-    std::mutex mtx;
-    std::condition_variable tripDoneCv; // controller waits for trip completion
-
-    Loc location = ISLAND;
-
-    int adultsOnIsland = 0;
-    int childrenOnIsland = 0;
-
-    Person* driver = nullptr;
-    Person* passenger = nullptr;
-    int boardedCount = 0;
-
-    // stats
-    int tripsToMain = 0, tripsToIsland = 0;
-    int twokidBoats = 0, kidAdultBoats = 0, soloBoats = 0;
-    int adultDrivers = 0, childDrivers = 0;
-
-    // RNG
-    std::mt19937 rng{std::random_device{}()};
-    // RNG for 1–4 second trip time said by the homework requirements
-    std::uniform_int_distribution<int> dist{1,4};
-
-    /**
-     * @brief Generates a random trip time between 1 and 4 seconds.
-     * 
-     * @param void
-     * 
-     * @return int Random trip time in seconds.
-     * 
-     * @details Uses the boat's internal uniform distribution and RNG to produce a value in the inclusive range [1,4].
-     */
-    int tripTime() { return dist(rng); }
-};
-
-static Boat* gBoat = nullptr;
+static void usage() {
+    std::cerr << "usage: ./bin/island <adults> <children> [options]" << std::endl
+              << "       ./bin/island --replay F" << std::endl
+              << "       ./bin/island --resume F" << std::endl
+              << "  --seed N          seed the trip-time RNG (default: random)" << std::endl
+              << "  --replicas N      run N virtual-time replicas and report distributions" << std::endl
+              << "  --ci-width W      keep adding replicas until the makespan 95% CI is at most W seconds wide" << std::endl
+              << "  --max-replicas N  upper bound on replicas for --ci-width (default 1000000)" << std::endl
+              << "  --policy P        crew selection: first-fit (default), least-rowed, round-robin, fifo, priority, edf" << std::endl
+              << "  --compare P,Q,..  compare policies on common random numbers (first is the baseline)" << std::endl
+              << "  --priority-classes K  give everyone a priority class 0 (most urgent) to K-1" << std::endl
+              << "  --deadline S      class k must reach the mainland within about S*(k+1) seconds; report misses" << std::endl
+              << "  --aggregate       use the vectorized aggregated simulator for --replicas (makespan only)" << std::endl
+              << "  --capacity-table  aggregated makespan table for every valid size up to <adults> <children>" << std::endl
+              << "  --chrome-trace F  write per-thread timelines to F (Trace Event Format, for Perfetto)" << std::endl
+              << "  --lifecycle       break each trip's non-travel time down by phase" << std::endl
+              << "  --event-log F     write every trip's lifecycle events to F (input of bin/critpath)" << std::endl
+              << "  --counters        print cv, spin and Boat::mtx lock counters of the threaded run" << std::endl
+              << "  --shadow          check every trip (capacity, shore counts, composition, row limits) on a separate thread" << std::endl
+              << "  --profile         sample CPU and wall time and print a flat profile by simulation phase" << std::endl
+              << "  --time-scale F    multiply every trip time by F (e.g. 0.001 for millisecond trips)" << std::endl
+              << "  --straggle P      fault injection: a woken crew member stalls before seating with probability P" << std::endl
+              << "  --straggle-time S how long a straggler stalls, in trip-time seconds (default 5)" << std::endl
+              << "  --boarding-timeout S  replace a crew member not seated within S trip-time seconds" << std::endl
+              << "  --record F        record the threaded run's seed, seats and trip times to F" << std::endl
+              << "  --replay F        replay a record in virtual time, printing the same narration and summary" << std::endl
+              << "  --checkpoint F    snapshot the threaded run to the memory-mapped file F between trips" << std::endl
+              << "  --checkpoint-every N  trips between snapshots (default 100)" << std::endl
+              << "  --resume F        continue the run saved in F, with the options it was started with" << std::endl
+              << "  --watchdog S      report the full state if no trip completes for S seconds" << std::endl
+              << "  --watchdog-abort  abort after the watchdog reports a stall" << std::endl
+              << "  --fleet N         run N independent boats of <adults> <children> each on epoll reactors" << std::endl
+              << "  --reactors K      reactor threads for --fleet (default 1)" << std::endl
+              << "  --islands N       N islands of <adults> <children> sharing the mainland docks, in virtual time" << std::endl
+              << "  --berths B        mainland berths for --islands (default N/8)" << std::endl
+              << "  --docks D         docks the berths are split over, each serving N/D islands (default B/8)" << std::endl
+              << "  --lps K           logical processes for --islands (default: cores; 0 = sequential)" << std::endl
+              << "  --arrival-rate R  open system: R arrivals per second join the <adults> <children> on the island" << std::endl
+              << "  --arrival-window S  seconds of arrivals for --arrival-rate (default 3600)" << std::endl
+              << "  --shore-capacity N  people the island shore holds for --arrival-rate (default unbounded)" << std::endl
+              << "  --admission P     at a full shore: reject (default), delay (backpressure) or shed (lowest priority)" << std::endl
+              << "  --rusage          print CPU time, peak RSS, context switches, peak threads and trips per CPU-second" << std::endl
+              << "  --rusage-json F   write the same resource usage to F as JSON" << std::endl;
+}
 
 /**
- * @brief The main execution loop for each Person thread.
- * 
- * @param void
+ * @brief Parse program arguments for number of adults and children.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @param opt Output options (filled on success).
  * 
- * @return void
+ * @return true if parsing succeeded, false otherwise.
  * 
- * @details person waits for their assignment as a driver or passenger,
- * performs the boat trip, updates the boat and personal state,
- * and handles termination conditions.
+ * @details Validates that exactly two positional numeric arguments are
+ *          provided and that both numbers are greater than zero, then reads
+ *          the optional `--flag value` settings described in `usage()`.
  */
-void Person::run() {
-    std::unique_lock<std::mutex> lk(gBoat->mtx);
-    while (true) {
-        // exit condition: I'm on mainland and won't be needed anymore
-        if (gBoat->adultsOnIsland == 0 && gBoat->childrenOnIsland == 0 && position == MAINLAND) {
-            return;
-        }
-
-        // Wait for assignment or final termination (when everyone is on mainland)
-        cv.wait(lk, [&]{
-            return role != NONE || (gBoat->adultsOnIsland == 0 && gBoat->childrenOnIsland == 0 && position == MAINLAND);
-        });
-
-        // if assigned as driver
-        if (role == DRIVER) {
-            // print boarding
-            std::cout << (isAdult ? "Adult " : "Child ") << id
-                      << " got into the driver's seat of the boat." << std::endl;
-            seated = true;
-            gBoat->boardedCount++;
-
-            // wait until passenger (if any) is seated as well
-            while (gBoat->passenger != nullptr && !gBoat->passenger->seated) {
-                // release lock briefly to let passenger proceed
-                gBoat->mtx.unlock();
-                std::this_thread::yield();
-                gBoat->mtx.lock();
+bool parse_args(int argc, char** argv, Options &opt) {
+    std::vector<std::string> positional;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) { positional.push_back(arg); continue; }
+            opt.flags++;
+            if (arg == "--aggregate") { opt.aggregate = true; continue; }
+            if (arg == "--capacity-table") { opt.capacityTable = true; continue; }
+            if (arg == "--lifecycle") { opt.lifecycle = true; continue; }
+            if (arg == "--counters") { opt.counters = true; continue; }
+            if (arg == "--shadow") { opt.shadow = true; continue; }
+            if (arg == "--profile") { opt.profile = true; continue; }
+            if (arg == "--watchdog-abort") { opt.watchdogAbort = true; continue; }
+            if (arg == "--rusage") { opt.rusage = true; continue; }
+            if (i + 1 >= argc) {
+                std::cerr << arg << " needs a value" << std::endl;
+                usage();
+                return false;
             }
-
-            // start trip: perform travel (release lock during sleep)
-            Loc start = gBoat->location;
-            Loc dest = (start == ISLAND ? MAINLAND : ISLAND);
-            gBoat->location = dest; // preflip
-
-            std::cout << "Boat is traveling from "
-                      << (start==ISLAND?"island":"mainland")
-                      << " to " << (dest==ISLAND?"island":"mainland") << std::endl;
-
-            int t = gBoat->tripTime();
-            gBoat->mtx.unlock();
-            std::this_thread::sleep_for(std::chrono::seconds(t));
-            gBoat->mtx.lock();
-
-            // move riders and update counts
-            auto movePerson = [&](Person* p) {
-                if (!p) return;
-                if (start == ISLAND) {
-                    if (p->isAdult) gBoat->adultsOnIsland--;
-                    else gBoat->childrenOnIsland--;
-                    p->position = MAINLAND;
-                } else {
-                    if (p->isAdult) gBoat->adultsOnIsland++;
-                    else gBoat->childrenOnIsland++;
-                    p->position = ISLAND;
+            std::string val = argv[++i];
+            if (arg == "--seed") { opt.seed = std::stoull(val); opt.haveSeed = true; }
+            else if (arg == "--replicas") opt.replicas = std::stol(val);
+            else if (arg == "--ci-width") opt.ciWidth = std::stod(val);
+            else if (arg == "--max-replicas") opt.maxReplicas = std::stol(val);
+            else if (arg == "--chrome-trace") opt.chromeTrace = val;
+            else if (arg == "--event-log") opt.eventLog = val;
+            else if (arg == "--time-scale") opt.timeScale = std::stod(val);
+            else if (arg == "--watchdog") opt.watchdog = std::stod(val);
+            else if (arg == "--rusage-json") opt.rusageJson = val;
+            else if (arg == "--record") opt.record = val;
+            else if (arg == "--replay") opt.replay = val;
+            else if (arg == "--checkpoint") opt.checkpoint = val;
+            else if (arg == "--checkpoint-every") opt.checkpointEvery = std::stol(val);
+            else if (arg == "--resume") opt.resume = val;
+            else if (arg == "--fleet") opt.fleet = std::stoi(val);
+            else if (arg == "--reactors") opt.reactors = static_cast<unsigned>(std::stoul(val));
+            else if (arg == "--islands") opt.islands = std::stoi(val);
+            else if (arg == "--berths") opt.berths = std::stoi(val);
+            else if (arg == "--docks") opt.docks = std::stoi(val);
+            else if (arg == "--lps") opt.lps = std::stol(val);
+            else if (arg == "--straggle") opt.straggle = std::stod(val);
+            else if (arg == "--straggle-time") opt.straggleTime = std::stod(val);
+            else if (arg == "--boarding-timeout") opt.boardingTimeout = std::stod(val);
+            else if (arg == "--priority-classes") opt.priorityClasses = std::stoi(val);
+            else if (arg == "--deadline") opt.deadline = std::stod(val);
+            else if (arg == "--arrival-rate") opt.arrivalRate = std::stod(val);
+            else if (arg == "--arrival-window") opt.arrivalWindow = std::stod(val);
+            else if (arg == "--shore-capacity") opt.shoreCapacity = std::stol(val);
+            else if (arg == "--admission") {
+                if (!parse_admission(val, opt.admission)) {
+                    std::cerr << "unknown admission policy " << val << std::endl;
+                    usage();
+                    return false;
                 }
-            };
-
-            movePerson(this);
-            movePerson(gBoat->passenger);
-
-            if (start == ISLAND) gBoat->tripsToMain++; else gBoat->tripsToIsland++;
-
-            // stats
-            if (gBoat->driver && gBoat->passenger) {
-                if (!gBoat->driver->isAdult && !gBoat->passenger->isAdult) gBoat->twokidBoats++;
-                else gBoat->kidAdultBoats++;
-            } else {
-                gBoat->soloBoats++;
-            }
-            if (gBoat->driver) {
-                if (gBoat->driver->isAdult) gBoat->adultDrivers++; else gBoat->childDrivers++;
             }
-
-            // consecutive row handling
-            if (gBoat->driver) {
-                gBoat->driver->consecutiveRows++;
-                if (gBoat->driver->consecutiveRows >= MAX_CONSECUTIVE) gBoat->driver->needsBreak = true;
+            else if (arg == "--policy" || arg == "--compare") {
+                std::vector<Policy> list;
+                std::size_t start = 0;
+                while (start <= val.size()) {
+                    std::size_t comma = val.find(',', start);
+                    if (comma == std::string::npos) comma = val.size();
+                    Policy p;
+                    if (!parse_policy(val.substr(start, comma - start), p)) {
+                        std::cerr << "unknown policy in " << val << std::endl;
+                        usage();
+                        return false;
+                    }
+                    list.push_back(p);
+                    start = comma + 1;
+                }
+                if (arg == "--policy") {
+                    if (list.size() != 1) { usage(); return false; }
+                    opt.policy = list[0];
+                } else {
+                    if (list.size() < 2) {
+                        std::cerr << "--compare needs at least two policies" << std::endl;
+                        return false;
+                    }
+                    opt.compare = list;
+                }
             }
-            if (gBoat->passenger) {
-                gBoat->passenger->consecutiveRows = 0;
-                gBoat->passenger->needsBreak = false;
+            else {
+                std::cerr << "unknown option " << arg << std::endl;
+                usage();
+                return false;
             }
-
-            // clear boat pointers and boarded flags
-            gBoat->driver = nullptr;
-            gBoat->passenger = nullptr;
-            gBoat->boardedCount = 0;
-
-            // // debug status
-            // std::cout << "[Status] location=" << (gBoat->location==ISLAND?"island":"mainland")
-            //           << ", adultsOnIsland=" << gBoat->adultsOnIsland
-            //           << ", childrenOnIsland=" << gBoat->childrenOnIsland << std::endl;
-
-            // wake controller and any passenger waiting (trip done)
-            gBoat->tripDoneCv.notify_all();
-
-            // reset my role/seated
-            role = NONE;
-            seated = false;
-
-            // if I'm on mainland now and nobody needs me, I may exit in next loop
-            continue;
         }
+    } catch (...) {
+        std::cerr << "option values must be numbers" << std::endl;
+        return false;
+    }
 
-        // if assigned passenger
-        if (role == PASSENGER) {
-            std::cout << (isAdult ? "Adult " : "Child ") << id
-                      << " got into the passenger seat of the boat." << std::endl;
-            seated = true;
-            gBoat->boardedCount++;
-
-            // wait for trip completion
-            gBoat->tripDoneCv.wait(lk);
-
-            // after trip, reset role/seated
-            role = NONE;
-            seated = false;
-            continue;
+    if (!opt.replay.empty()) {
+        if (!positional.empty() || opt.flags > 1) {
+            std::cerr << "--replay takes the record file and nothing else" << std::endl;
+            return false;
         }
+        return true;
     }
-}
-
-/**
- * @brief Parse program arguments for number of adults and children.
- *
- * @param argc Argument count.
- * @param argv Argument vector.
- * @param A Output adults count (filled on success).
- * @param C Output children count (filled on success).
- * 
- * @return true if parsing succeeded, false otherwise.
- * 
- * @details Validates that exactly two numeric arguments are provided and
- *          that both numbers are greater than zero. On success `A` and `C`
- *          are set to the parsed values.
- */
-bool parse_args(int argc, char** argv, int &A, int &C) {
-    if (argc != 3) {
-        std::cerr << "usage: ./bin/island <adults> <children>" << std::endl;
+    if (!opt.resume.empty()) {
+        if (!positional.empty() || opt.flags > 1) {
+            std::cerr << "--resume takes the checkpoint file and nothing else" << std::endl;
+            return false;
+        }
+        if (!Engine::capture) {
+            std::cerr << "this build has no instrumentation; use bin/island" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (positional.size() != 2) {
+        usage();
         return false;
     }
 
+    int &A = opt.adults;
+    int &C = opt.children;
     try {
-        A = std::stoi(argv[1]);
-        C = std::stoi(argv[2]);
+        A = std::stoi(positional[0]);
+        C = std::stoi(positional[1]);
     } catch (...) {
         std::cerr << "inputs must be integers" << std::endl;
         return false;
@@ -285,210 +319,146 @@ bool parse_args(int argc, char** argv, int &A, int &C) {
         return false;
     }
 
-    return true;
-}
-
-
-/**
- * @brief Initialize person objects and assign them to the boat.
- *
- * @param boat Pointer to the shared Boat instance.
- * @param A Number of adults.
- * @param C Number of children.
- * 
- * @return std::vector<std::unique_ptr<Person>> Container of created people.
- * 
- * @details Allocates `A` adult and `C` child `Person` instances, sets their
- *          initial positions to `ISLAND`, assigns the shared `boat` pointer,
- *          and returns the owning vector of unique pointers.
- */
-std::vector<std::unique_ptr<Person>> init_people(Boat* boat, int A, int C) {
-    std::vector<std::unique_ptr<Person>> people;
-    people.reserve(A + C);
-    for (int i = 0; i < A; ++i) {
-        auto p = std::make_unique<Person>();
-        p->id = i+1;
-        p->isAdult = true;
-        p->position = ISLAND;
-        p->boat = boat;
-        people.push_back(std::move(p));
-    }
-    for (int i = 0; i < C; ++i) {
-        auto p = std::make_unique<Person>();
-        p->id = i+1;
-        p->isAdult = false;
-        p->position = ISLAND;
-        p->boat = boat;
-        people.push_back(std::move(p));
-    }
-    return people;
-}
-
-/**
- * @brief Find a person matching criteria.
- *
- * @param people Container of person pointers.
- * @param wantAdult true for adult, false for child.
- * @param where Location to search (ISLAND/MAINLAND).
- * @param excludeNeedsBreak whether to exclude those needing a break.
- * 
- * @return Person* or nullptr if none found.
- * 
- * @details Scans `people` for a person matching the requested age and
- *          location, who is not already assigned (`role == NONE`). The
- *          first pass prefers persons below the consecutive-row limit; the
- *          second pass relaxes that preference but still honors
- *          `excludeNeedsBreak` if requested.
- */
-Person* find_person(std::vector<std::unique_ptr<Person>> &people, bool wantAdult, Loc where, bool excludeNeedsBreak = true) {
-    for (auto &p : people) {
-        if (p->isAdult != wantAdult) continue;
-        if (p->position != where) continue;
-        if (p->role != Person::NONE) continue;
-        if (excludeNeedsBreak && p->needsBreak) continue;
-        if (p->consecutiveRows >= MAX_CONSECUTIVE) continue;
-        return p.get();
-    }
-    for (auto &p : people) {
-        if (p->isAdult != wantAdult) continue;
-        if (p->position != where) continue;
-        if (p->role != Person::NONE) continue;
-        if (excludeNeedsBreak && p->needsBreak) continue;
-        return p.get();
-    }
-    return nullptr;
-}
-
-/**
- * @brief Controller loop that orchestrates deterministic ferrying of people.
- *
- * @param boat Reference to shared Boat.
- * @param people Container of people.
- * 
- * @return void
- * 
- * @details Implementation: it repeatedly moves two children,
- *          returns one, ships an adult with a child driving, and returns a
- *          child, until all adults are moved; then it moves remaining
- *          children. The function holds the boat mutex while deciding and
- *          notifying riders, and releases it while waiting for trip
- *          completion.
- */
-void controller_loop(Boat &boat, std::vector<std::unique_ptr<Person>> &people) {
-    std::unique_lock<std::mutex> lk(boat.mtx);
-
-    while (boat.adultsOnIsland > 0) {
-        // 1) Two children go island -> mainland
-        Person* c1 = find_person(people, false, ISLAND, /*excludeNeedsBreak=*/false);
-        Person* c2 = nullptr;
-        if (c1) {
-            for (auto &p : people) if (!p->isAdult && p->position==ISLAND && p->role==Person::NONE && p.get()!=c1) { c2 = p.get(); break; }
-        }
-        if (!c1 || !c2) break;
-        boat.driver = c1; boat.passenger = c2;
-        c1->role = Person::DRIVER; c2->role = Person::PASSENGER; c1->seated = c2->seated = false;
-        c1->cv.notify_one(); c2->cv.notify_one();
-        boat.tripDoneCv.wait(lk);
-
-        // 2) One child returns mainland -> island
-        Person* rc = find_person(people, false, MAINLAND, /*excludeNeedsBreak=*/false);
-        if (!rc) rc = find_person(people, true, MAINLAND, /*excludeNeedsBreak=*/false);
-        if (!rc) break;
-        boat.driver = rc; boat.passenger = nullptr; rc->role = Person::DRIVER; rc->seated = false; rc->cv.notify_one();
-        boat.tripDoneCv.wait(lk);
-
-        // 3) One adult + one child go island -> mainland (child drives)
-        Person* adult = find_person(people, true, ISLAND, false);
-        Person* child = find_person(people, false, ISLAND, false);
-        if (!adult || !child) break;
-        boat.driver = child; boat.passenger = adult; child->role = Person::DRIVER; adult->role = Person::PASSENGER;
-        child->seated = adult->seated = false; child->cv.notify_one(); adult->cv.notify_one();
-        boat.tripDoneCv.wait(lk);
-
-        // 4) One child returns mainland -> island
-        Person* rc2 = find_person(people, false, MAINLAND, false);
-        if (!rc2) rc2 = find_person(people, true, MAINLAND, false);
-        if (!rc2) break;
-        boat.driver = rc2; boat.passenger = nullptr; rc2->role = Person::DRIVER; rc2->seated = false; rc2->cv.notify_one();
-        boat.tripDoneCv.wait(lk);
+    if (opt.replicas < 0 || opt.ciWidth < 0 || opt.maxReplicas <= 0) {
+        std::cerr << "replica settings must be positive" << std::endl;
+        return false;
     }
-
-    // Move remaining children in pairs (or solo)
-    while (boat.childrenOnIsland > 0) {
-        if (boat.childrenOnIsland >= 2) {
-            Person* c1 = find_person(people, false, ISLAND);
-            Person* c2 = nullptr;
-            if (c1) for (auto &p : people) if (!p->isAdult && p->position==ISLAND && p->role==Person::NONE && p.get()!=c1) { c2 = p.get(); break; }
-            if (c1 && c2) {
-                boat.driver = c1; boat.passenger = c2;
-                c1->role = Person::DRIVER; c2->role = Person::PASSENGER;
-                c1->seated = c2->seated = false;
-                c1->cv.notify_one(); c2->cv.notify_one();
-                boat.tripDoneCv.wait(lk);
-            } else break;
-        } else {
-            Person* c = find_person(people, false, ISLAND);
-            if (c) {
-                boat.driver = c; c->role = Person::DRIVER; c->seated=false; c->cv.notify_one();
-                boat.tripDoneCv.wait(lk);
-            } else break;
-        }
+    if (opt.ciWidth > 0 && opt.replicas == 0) opt.replicas = 100;
+    if (!opt.compare.empty() && opt.replicas == 0) opt.replicas = 1000;
+    if ((opt.aggregate || opt.capacityTable) && opt.replicas == 0) opt.replicas = 100000;
+    bool lifecycle = opt.lifecycle || !opt.eventLog.empty();
+    if (opt.replicas > 0 && (!opt.chromeTrace.empty() || lifecycle || opt.counters || opt.profile)) {
+        std::cerr << "--chrome-trace, --lifecycle, --event-log, --counters and --profile record the threaded simulation and cannot be used with replicas" << std::endl;
+        return false;
+    }
+    if ((!Engine::timestamps && (!opt.chromeTrace.empty() || lifecycle)) ||
+        (!Engine::counters && !Engine::lockProfiling && opt.counters) ||
+        (!Engine::counters && opt.watchdog > 0) || (!Engine::phases && opt.profile) ||
+        (!Engine::faults && (opt.straggle > 0 || opt.boardingTimeout > 0)) ||
+        (!Engine::capture && (!opt.record.empty() || !opt.checkpoint.empty()))) {
+        std::cerr << "this build has no instrumentation; use bin/island" << std::endl;
+        return false;
+    }
+    if (opt.timeScale < 0) {
+        std::cerr << "--time-scale must not be negative" << std::endl;
+        return false;
+    }
+    if (opt.watchdog < 0 || (opt.watchdogAbort && opt.watchdog == 0)) {
+        std::cerr << "--watchdog needs a positive interval (and is required by --watchdog-abort)" << std::endl;
+        return false;
+    }
+    if (opt.watchdog > 0 && opt.replicas > 0) {
+        std::cerr << "--watchdog watches the threaded simulation and cannot be used with replicas" << std::endl;
+        return false;
+    }
+    if (opt.fleet < 0 || opt.reactors == 0) {
+        std::cerr << "--fleet and --reactors must be positive" << std::endl;
+        return false;
+    }
+    if (opt.fleet > 0 && (opt.replicas > 0 || !opt.chromeTrace.empty() || lifecycle || opt.counters ||
+                          opt.profile || opt.watchdog > 0)) {
+        std::cerr << "--fleet runs the model on reactors and cannot be combined with replicas or the threaded-run instrumentation" << std::endl;
+        return false;
+    }
+    if (opt.islands < 0 || opt.berths < 0 || opt.docks < 0 || opt.lps < -1 || (opt.islands > 0 && opt.lps > opt.islands)) {
+        std::cerr << "--islands, --berths and --docks must be positive and --lps at most the number of islands" << std::endl;
+        return false;
+    }
+    if (opt.islands > 0 && (opt.replicas > 0 || opt.fleet > 0 || !opt.chromeTrace.empty() || lifecycle ||
+                            opt.counters || opt.profile || opt.watchdog > 0)) {
+        std::cerr << "--islands is its own virtual-time mode and cannot be combined with replicas, --fleet or the threaded-run instrumentation" << std::endl;
+        return false;
+    }
+    if (opt.arrivalRate < 0 || opt.arrivalWindow < 0 || opt.shoreCapacity < 0) {
+        std::cerr << "--arrival-rate, --arrival-window and --shore-capacity must not be negative" << std::endl;
+        return false;
+    }
+    if (opt.shoreCapacity == 1) {
+        std::cerr << "--shore-capacity must leave a place for the rower coming back, so it must be at least 2" << std::endl;
+        return false;
+    }
+    if (opt.arrivalRate > 0 && (opt.replicas > 0 || opt.fleet > 0 || opt.islands > 0 || !opt.chromeTrace.empty() ||
+                                lifecycle || opt.counters || opt.profile || opt.watchdog > 0)) {
+        std::cerr << "--arrival-rate is its own virtual-time mode and cannot be combined with replicas, --fleet, --islands or the threaded-run instrumentation" << std::endl;
+        return false;
+    }
+    if (opt.straggle < 0 || opt.straggle > 1 || opt.straggleTime < 0 || opt.boardingTimeout < 0) {
+        std::cerr << "--straggle must be between 0 and 1, --straggle-time and --boarding-timeout must not be negative" << std::endl;
+        return false;
+    }
+    if ((opt.straggle > 0 || opt.boardingTimeout > 0) &&
+        (opt.replicas > 0 || opt.fleet > 0 || opt.islands > 0 || opt.arrivalRate > 0 || opt.timeScale == 0)) {
+        std::cerr << "--straggle and --boarding-timeout apply to the threaded run with a positive --time-scale" << std::endl;
+        return false;
+    }
+    if (!opt.record.empty() && (opt.replicas > 0 || opt.fleet > 0 || opt.islands > 0 || opt.arrivalRate > 0)) {
+        std::cerr << "--record records the threaded run" << std::endl;
+        return false;
+    }
+    // a recorded run needs a known seed for the priority classes and deadlines
+    if (!opt.record.empty() && !opt.haveSeed) {
+        opt.seed = std::random_device{}();
+        opt.haveSeed = true;
+    }
+    if (!opt.checkpoint.empty() && (opt.replicas > 0 || opt.fleet > 0 || opt.islands > 0 || opt.arrivalRate > 0)) {
+        std::cerr << "--checkpoint snapshots the threaded run" << std::endl;
+        return false;
+    }
+    if (opt.checkpointEvery < 1) {
+        std::cerr << "--checkpoint-every must be at least 1" << std::endl;
+        return false;
+    }
+    // a resumed run reseeds the priority classes and deadlines from the same seed
+    if (!opt.checkpoint.empty() && !opt.haveSeed) {
+        opt.seed = std::random_device{}();
+        opt.haveSeed = true;
+    }
+    if (opt.shadow && (opt.replicas > 0 || opt.fleet > 0 || opt.islands > 0 || opt.arrivalRate > 0)) {
+        std::cerr << "--shadow validates the threaded run" << std::endl;
+        return false;
+    }
+    bool triage = opt.priorityClasses != 1 || opt.deadline != 0;
+    if (opt.priorityClasses < 1 || opt.deadline < 0) {
+        std::cerr << "--priority-classes must be at least 1 and --deadline must not be negative" << std::endl;
+        return false;
+    }
+    if (triage && (opt.fleet > 0 || opt.islands > 0)) {
+        std::cerr << "--priority-classes and --deadline apply to the threaded run, replicas and --arrival-rate" << std::endl;
+        return false;
+    }
+    // the threaded run keeps waiting lines and landing times only with the Scheduling knob
+    bool threaded = opt.replicas == 0 && opt.fleet == 0 && opt.islands == 0 && opt.arrivalRate == 0;
+    if ((!Engine::shadow && opt.shadow) ||
+        (!Engine::scheduling && threaded &&
+         (triage || opt.policy == Policy::FIFO || opt.policy == Policy::PRIORITY || opt.policy == Policy::EDF))) {
+        std::cerr << "this build has no instrumentation; use bin/island" << std::endl;
+        return false;
+    }
+    if ((opt.aggregate || opt.capacityTable) &&
+        (!opt.compare.empty() || opt.ciWidth > 0 || opt.policy != Policy::FIRST_FIT || triage)) {
+        std::cerr << "the aggregated simulator only models the first-fit policy with a fixed replica count and no triage" << std::endl;
+        return false;
     }
 
-    // wake anyone still blocked to let threads exit
-    for (auto &p : people) p->cv.notify_one();
-
-    // unlock while joining threads
-    lk.unlock();
+    return true;
 }
 
-/**
- * @brief Start threads for all people in container.
- *
- * @param people Container of people whose threads will be started.
- * 
- * @return void
- * 
- * @details Creates a `std::thread` for each `Person` that runs
- *          `Person::run()` and stores it in the person's `th` member.
- */
-void start_threads(std::vector<std::unique_ptr<Person>> &people) {
-    for (auto &p : people) p->th = std::thread(&Person::run, p.get());
-}
 
 /**
- * @brief Join all threads in people container.
+ * @brief Report the resource usage of the run, if asked for.
  *
- * @param people Container of people whose threads will be joined.
- * 
- * @return void
- * 
- * @details Joins each person's thread if it is joinable to ensure clean
- *          termination before the program exits.
- */
-void join_threads(std::vector<std::unique_ptr<Person>> &people) {
-    for (auto &p : people) if (p->th.joinable()) p->th.join();
-}
-
-/**
- * @brief Print a concise summary of the boat statistics.
+ * @param opt Options (`--rusage`, `--rusage-json`).
+ * @param usage Measured usage.
  *
- * @param boat Reference to the Boat whose stats will be printed.
- * 
- * @return void
- * 
- * @details Prints trip counts and driver statistics collected during the
- *          simulation to standard output.
+ * @return bool false if the JSON file could not be written.
  */
-void print_summary(Boat &boat) {
-    std::cout << "Summary of Events" << std::endl;
-    std::cout << "Boat traveled to the mainland: " << boat.tripsToMain << std::endl;
-    std::cout << "Boat returned to the island: " << boat.tripsToIsland << std::endl;
-    std::cout << "Boats with 2 children: " << boat.twokidBoats << std::endl;
-    std::cout << "Boats with 1 child and 1 adult: " << boat.kidAdultBoats << std::endl;
-    std::cout << "Boats with only 1 person (child or adult): " << boat.soloBoats << std::endl;
-    std::cout << "Times adults were the driver: " << boat.adultDrivers << std::endl;
-    std::cout << "Times children were the driver: " << boat.childDrivers << std::endl;
+static bool report_resources(const Options &opt, const ResourceUsage &usage) {
+    if (opt.rusage) usage.print(std::cout);
+    if (!opt.rusageJson.empty() && !usage.write_json(opt.rusageJson)) {
+        std::cerr << "could not write " << opt.rusageJson << std::endl;
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -501,23 +471,240 @@ void print_summary(Boat &boat) {
  * 
  * @details Parses arguments, initializes state, starts person threads,
  *          runs the deterministic controller loop, joins threads, and
- *          prints a summary of the simulation.
+ *          prints a summary of the simulation. With `--replicas` it runs
+ *          the virtual-time model instead and prints distributions.
+ *          Returns 1 on bad arguments or when `--shadow` found a broken rule.
  */
 int main(int argc, char** argv) {
 
-    int A = 0, C = 0;
-    if (!parse_args(argc, argv, A, C)) return 1;
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 1;
+    int A = opt.adults, C = opt.children;
+
+    if (!opt.replay.empty()) {
+        RunRecord rec;
+        std::string error;
+        if (!rec.read(opt.replay, error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        return run_replay(rec, std::cout);
+    }
+
+    // a resumed run is the threaded run it was started as, with its state restored below
+    std::unique_ptr<Checkpoint> checkpoint;
+    if (!opt.resume.empty()) {
+        std::string error;
+        checkpoint = Checkpoint::open(opt.resume, error);
+        if (!checkpoint) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        const CheckpointConfig &cfg = checkpoint->config();
+        A = opt.adults = cfg.adults;
+        C = opt.children = cfg.children;
+        opt.policy = static_cast<Policy>(cfg.policy);
+        opt.seed = cfg.seed;
+        opt.haveSeed = true;
+        opt.priorityClasses = cfg.classes;
+        opt.deadline = cfg.deadline;
+        opt.timeScale = cfg.timeScale;
+        opt.straggle = cfg.straggle;
+        opt.straggleTime = cfg.straggleTime;
+        opt.boardingTimeout = cfg.boardingTimeout;
+        opt.checkpointEvery = static_cast<long>(cfg.every);
+    }
+
+    bool measure = opt.rusage || !opt.rusageJson.empty();
+    ResourceMonitor monitor;
+    ResourceUsage usage;
+    usage.adults = A;
+    usage.children = C;
+    usage.policy = policy_name(opt.policy);
+    if (measure) monitor.start();
+
+    if (opt.replicas > 0) {
+        ReplicaConfig cfg;
+        cfg.adults = A;
+        cfg.children = C;
+        cfg.seed = opt.haveSeed ? opt.seed : std::random_device{}();
+        cfg.replicas = opt.replicas;
+        cfg.ciWidth = opt.ciWidth;
+        cfg.maxReplicas = opt.maxReplicas;
+        cfg.policy = opt.policy;
+        cfg.triage.classes = opt.priorityClasses;
+        cfg.triage.deadline = opt.deadline;
+        int rc;
+        if (opt.capacityTable) { usage.mode = "capacity-table"; rc = run_capacity_table(A, C, cfg.seed, cfg.replicas); }
+        else if (opt.aggregate) { usage.mode = "aggregate"; rc = run_aggregate(A, C, cfg.seed, cfg.replicas); }
+        else if (!opt.compare.empty()) { usage.mode = "compare"; rc = run_comparison(cfg, opt.compare); }
+        else { usage.mode = "replicas"; rc = run_replicas(cfg); }
+        if (measure) monitor.stop(usage);
+        if (measure && !report_resources(opt, usage)) return 1;
+        return rc;
+    }
+
+    if (opt.arrivalRate > 0) {
+        OpenConfig cfg;
+        cfg.adults = A;
+        cfg.children = C;
+        cfg.rate = opt.arrivalRate;
+        cfg.duration = opt.arrivalWindow;
+        cfg.capacity = opt.shoreCapacity;
+        cfg.admission = opt.admission;
+        cfg.policy = opt.policy;
+        cfg.triage.classes = opt.priorityClasses;
+        cfg.triage.deadline = opt.deadline;
+        cfg.seed = opt.haveSeed ? opt.seed : std::random_device{}();
+        usage.mode = "open";
+        int rc = run_open_system(cfg, usage.trips);
+        if (measure) monitor.stop(usage);
+        if (measure && !report_resources(opt, usage)) return 1;
+        return rc;
+    }
+
+    if (opt.islands > 0) {
+        PdesConfig cfg;
+        cfg.islands = opt.islands;
+        cfg.adults = A;
+        cfg.children = C;
+        cfg.berths = opt.berths ? opt.berths : std::max(1, opt.islands / 8);
+        cfg.docks = opt.docks ? opt.docks : std::max(1, cfg.berths / 8);
+        if (cfg.docks > cfg.berths || cfg.docks > cfg.islands) {
+            std::cerr << "--docks must be at most the number of berths and of islands" << std::endl;
+            return 1;
+        }
+        cfg.seed = opt.haveSeed ? opt.seed : std::random_device{}();
+        cfg.policy = opt.policy;
+        cfg.lps = opt.lps < 0 ? std::min<unsigned>(worker_count(0), opt.islands) : static_cast<unsigned>(opt.lps);
+        int rc = run_pdes(cfg, usage.trips);
+        usage.mode = cfg.lps ? "pdes" : "islands";
+        if (measure) monitor.stop(usage);
+        if (measure && !report_resources(opt, usage)) return 1;
+        return rc;
+    }
+
+    if (opt.fleet > 0) {
+        FleetConfig cfg;
+        cfg.boats = opt.fleet;
+        cfg.adults = A;
+        cfg.children = C;
+        cfg.seed = opt.haveSeed ? opt.seed : std::random_device{}();
+        cfg.policy = opt.policy;
+        cfg.tripUnit = std::chrono::microseconds(static_cast<long>(1e6 * opt.timeScale));
+        cfg.reactors = opt.reactors;
+        int rc = run_fleet(cfg, usage.trips);
+        usage.mode = "fleet";
+        if (measure) monitor.stop(usage);
+        if (measure && !report_resources(opt, usage)) return 1;
+        return rc;
+    }
 
     Boat boat;
     boat.adultsOnIsland = A;
     boat.childrenOnIsland = C;
-    gBoat = &boat;
+    boat.policy = opt.policy;
+    if (opt.haveSeed) boat.rng.seed(static_cast<std::mt19937::result_type>(opt.seed));
+    boat.tripUnit = std::chrono::microseconds(static_cast<long>(1e6 * opt.timeScale));
+    boat.watchdog = std::chrono::milliseconds(static_cast<long>(1e3 * opt.watchdog));
+    boat.watchdogAbort = opt.watchdogAbort;
+    boat.straggleRate = opt.straggle;
+    boat.straggleTime = opt.straggleTime;
+    boat.boardingTimeout = opt.boardingTimeout;
+    boat.trackBoarding = opt.straggle > 0 || opt.boardingTimeout > 0;
+    if (opt.haveSeed) boat.faultRng.seed(static_cast<std::mt19937::result_type>(opt.seed ^ 0x5DEECE66DULL));
+    std::unique_ptr<ChromeTrace> trace;
+    if (!opt.chromeTrace.empty()) {
+        trace = std::make_unique<ChromeTrace>();
+        boat.trace = trace.get();
+    }
+    std::unique_ptr<LifecycleLog> lifecycle;
+    if (opt.lifecycle || !opt.eventLog.empty()) {
+        lifecycle = std::make_unique<LifecycleLog>();
+        boat.lifecycle = lifecycle.get();
+    }
 
-    auto people = init_people(gBoat, A, C);
-    start_threads(people);
-    controller_loop(boat, people);
-    join_threads(people);
+    if (Engine::recorder) flight_install();
+    Triage triage;
+    triage.classes = opt.priorityClasses;
+    triage.deadline = opt.deadline;
+    triage.seed = opt.haveSeed ? opt.seed : std::random_device{}();
+    auto people = init_people(&boat, A, C, triage);
+    if (checkpoint) {
+        std::string error;
+        if (!checkpoint->restore(boat, people, error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    } else if (!opt.checkpoint.empty()) {
+        CheckpointConfig cfg;
+        cfg.adults = A;
+        cfg.children = C;
+        cfg.policy = static_cast<std::int32_t>(opt.policy);
+        cfg.classes = opt.priorityClasses;
+        cfg.seed = opt.seed;
+        cfg.deadline = opt.deadline;
+        cfg.timeScale = opt.timeScale;
+        cfg.straggle = opt.straggle;
+        cfg.straggleTime = opt.straggleTime;
+        cfg.boardingTimeout = opt.boardingTimeout;
+        cfg.every = opt.checkpointEvery;
+        std::string error;
+        checkpoint = Checkpoint::create(opt.checkpoint, cfg, error);
+        if (!checkpoint) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    }
+    boat.checkpoint = checkpoint.get();
+    RunRecord record;
+    if (!opt.record.empty()) {
+        record.adults = A;
+        record.children = C;
+        record.policy = opt.policy;
+        record.seed = opt.seed;
+        record.triage = triage;
+        boat.record = &record;
+    }
+    std::unique_ptr<ShadowValidator> shadow;
+    if (opt.shadow) {
+        shadow = std::make_unique<ShadowValidator>(A, C);
+        boat.shadow = shadow.get();
+        shadow->start();
+    }
+    Profiler profiler;
+    if (opt.profile) profiler.start();
+    auto started = std::chrono::steady_clock::now();
+    run_simulation<Engine>(boat, people);
+    double makespan = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (opt.profile) profiler.stop();
+    if (shadow) shadow->stop();
+    if (measure) monitor.stop(usage);
     print_summary(boat);
+    usage.mode = "threaded";
+    usage.trips = boat.tripsToMain + boat.tripsToIsland;
+    if (measure && !report_resources(opt, usage)) return 1;
+    if (triage.classes > 1 || triage.deadline > 0) print_triage(std::cout, people, triage);
+    if (boat.trackBoarding) print_boarding(boat, makespan, std::cout);
+    if (opt.lifecycle) lifecycle->print(std::cout);
+    if (opt.counters) print_counters(boat, people, std::cout);
+    if (opt.profile) profiler.print(std::cout);
+    if (shadow) shadow->print(std::cout);
+    // on stderr, so a resumed run prints the same summary as an uninterrupted one
+    if (checkpoint) checkpoint->print(std::cerr);
+
+    if (trace && !trace->write(opt.chromeTrace)) {
+        std::cerr << "could not write " << opt.chromeTrace << std::endl;
+        return 1;
+    }
+    if (!opt.eventLog.empty() && !lifecycle->write_events(opt.eventLog)) {
+        std::cerr << "could not write " << opt.eventLog << std::endl;
+        return 1;
+    }
+    if (!opt.record.empty() && !record.write(opt.record)) {
+        std::cerr << "could not write " << opt.record << std::endl;
+        return 1;
+    }
 
-    return 0;
+    return shadow && shadow->violation_count() > 0 ? 1 : 0;
 }
@@ -0,0 +1,19 @@
+/**
+ * @file src/island.h
+ *
+ * @brief Definitions shared by the threaded simulation and the sequential model.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#ifndef ISLAND_H
+#define ISLAND_H
+
+// Global boat state of either ISLAND or MAINLAND
+enum Loc { ISLAND, MAINLAND };
+
+// maximum consecutive times a person may drive the boat
+static const int MAX_CONSECUTIVE = 4;
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file src/lifecycle.cpp
+ *
+ * @brief Per-trip lifecycle timestamps and the coordination-overhead breakdown.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "lifecycle.h"
+
+#include <cstdio>
+#include <iomanip>
+
+#include "stats.h"
+
+/**
+ * @brief Event name of a lifecycle point, as used in event traces.
+ *
+ * @param p Point.
+ *
+ * @return const char* Name.
+ */
+const char* lifecycle_point_name(LifecyclePoint p) {
+    static const char* names[LC_COUNT] = {
+        "select", "decide", "driver_woken", "driver_seated", "passenger_woken",
+        "passenger_seated", "depart", "arrive", "notify", "observe",
+    };
+    return p >= 0 && p < LC_COUNT ? names[p] : "?";
+}
+
+/**
+ * @brief Start the timeline of a new trip.
+ *
+ * @param selectStart When the controller started choosing this crew.
+ * @param driver Driver's id.
+ * @param driverAdult Whether the driver is an adult.
+ * @param passenger Passenger's id, 0 when rowing alone.
+ * @param passengerAdult Whether the passenger is an adult.
+ *
+ * @return void
+ *
+ * @details Called by the controller right after it notified the crew, so
+ *          the decision time is stamped here as well.
+ */
+void LifecycleLog::begin_trip(std::uint64_t selectStart, int driver, bool driverAdult, int passenger, bool passengerAdult) {
+    TripTimeline t;
+    t.driver = driver;
+    t.driverAdult = driverAdult;
+    t.passenger = passenger;
+    t.passengerAdult = passengerAdult;
+    t.hasPassenger = passenger != 0;
+    t.at[LC_SELECT_START] = selectStart;
+    t.at[LC_DECIDED] = now();
+    trips.push_back(t);
+}
+
+/**
+ * @brief Print where each trip's time went, as percentiles in microseconds.
+ *
+ * @param os Output stream.
+ *
+ * @return void
+ *
+ * @details Phases of a trip (each from the end of the previous one):
+ *          selection (choosing the crew), wakeup (until the driver runs),
+ *          seating (driver sits down), spinning (driver waits for the
+ *          passenger), travel (rowing) and notification (until the
+ *          controller has seen the trip finish). Everything except travel
+ *          is coordination overhead.
+ */
+void LifecycleLog::print(std::ostream &os) const {
+    static const char* names[] = {"selection", "wakeup", "seating", "spinning", "travel", "notification"};
+    static const LifecyclePoint bounds[][2] = {
+        {LC_SELECT_START, LC_DECIDED}, {LC_DECIDED, LC_DRIVER_WOKEN},
+        {LC_DRIVER_WOKEN, LC_DRIVER_SEATED}, {LC_DRIVER_SEATED, LC_DEPARTED},
+        {LC_DEPARTED, LC_ARRIVED}, {LC_ARRIVED, LC_OBSERVED},
+    };
+    const int phases = 6, travel = 4;
+
+    std::vector<std::vector<double>> samples(phases);
+    double total[phases] = {};
+    std::size_t complete = 0;
+    for (auto &t : trips) {
+        if (!t.at[LC_OBSERVED] || !t.at[LC_ARRIVED]) continue; // trip never finished
+        complete++;
+        for (int i = 0; i < phases; ++i) {
+            double us = (t.at[bounds[i][1]] - t.at[bounds[i][0]]) / 1000.0;
+            samples[i].push_back(us);
+            total[i] += us;
+        }
+    }
+
+    double sum = 0;
+    for (double v : total) sum += v;
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize prec = os.precision();
+    os << "Trip Lifecycle (" << complete << " trips, microseconds)" << std::endl;
+    os << std::left << std::setw(14) << "phase" << std::right
+       << std::setw(12) << "p50" << std::setw(12) << "p90" << std::setw(12) << "p99"
+       << std::setw(14) << "max" << std::setw(10) << "share" << std::endl;
+    os << std::fixed << std::setprecision(1);
+    for (int i = 0; i < phases; ++i) {
+        Summary s = summarize(samples[i]);
+        os << std::left << std::setw(14) << names[i] << std::right
+           << std::setw(12) << s.p50 << std::setw(12) << s.p90 << std::setw(12) << s.p99
+           << std::setw(14) << s.max << std::setprecision(3) << std::setw(9) << (sum > 0 ? 100 * total[i] / sum : 0) << "%"
+           << std::setprecision(1) << std::endl;
+    }
+    double overhead = sum - total[travel];
+    os << "Coordination overhead: " << overhead / 1000.0 << " ms of " << sum / 1000.0
+       << " ms (" << std::setprecision(3) << (sum > 0 ? 100 * overhead / sum : 0) << "% of makespan)"
+       << std::endl;
+    os.flags(flags);
+    os.precision(prec);
+}
+
+/**
+ * @brief Write the log as an event trace (format in lifecycle.h).
+ *
+ * @param path Output file.
+ *
+ * @return true on success.
+ */
+bool LifecycleLog::write_events(const std::string &path) const {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fputs("# island events v1\n", f);
+    for (std::size_t i = 0; i < trips.size(); ++i) {
+        const TripTimeline &t = trips[i];
+        for (int p = 0; p < LC_COUNT; ++p) {
+            if (p != LC_SELECT_START && !t.at[p]) continue; // never reached
+            unsigned long long ns = t.at[p];
+            if (p == LC_DECIDED) {
+                char passenger[16] = "-";
+                if (t.hasPassenger) std::snprintf(passenger, sizeof passenger, "%c%d", t.passengerAdult ? 'A' : 'C', t.passenger);
+                std::fprintf(f, "%zu decide %llu %c%d %s\n", i, ns, t.driverAdult ? 'A' : 'C', t.driver, passenger);
+            } else {
+                std::fprintf(f, "%zu %s %llu\n", i, lifecycle_point_name(static_cast<LifecyclePoint>(p)), ns);
+            }
+        }
+    }
+    bool ok = !std::ferror(f);
+    return std::fclose(f) == 0 && ok;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file src/lifecycle.h
+ *
+ * @brief Per-trip lifecycle timestamps and the coordination-overhead breakdown.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Every trip goes through the same points, from the controller starting to
+ * look for a crew to the controller seeing `tripDoneCv` fire. The log keeps
+ * a timestamp for each point of each trip; all marks are made while holding
+ * `Boat::mtx`, so the log needs no locking of its own.
+ *
+ * `write_events` saves the log as an event trace for `bin/critpath`, one
+ * event per line:
+ *
+ *     # island events v1
+ *     <trip> decide <ns> <driver> <passenger|->     e.g. "4 decide 81234 C2 A1"
+ *     <trip> <point> <ns>                          for every other point reached
+ *
+ * Lines of one trip are contiguous; trips appear in order.
+ */
+
+#ifndef LIFECYCLE_H
+#define LIFECYCLE_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @enum LifecyclePoint
+ *
+ * @brief Points of a trip, in the order they normally happen.
+ */
+enum LifecyclePoint {
+    LC_SELECT_START,     // controller starts choosing (previous trip observed)
+    LC_DECIDED,          // crew assigned and notified
+    LC_DRIVER_WOKEN,     // driver thread returned from its cv wait
+    LC_DRIVER_SEATED,
+    LC_PASSENGER_WOKEN,
+    LC_PASSENGER_SEATED,
+    LC_DEPARTED,         // driver releases the lock to travel
+    LC_ARRIVED,          // driver holds the lock again after travel
+    LC_NOTIFIED,         // driver calls tripDoneCv.notify_all()
+    LC_OBSERVED,         // controller returned from tripDoneCv.wait()
+    LC_COUNT
+};
+
+/**
+ * @struct TripTimeline
+ *
+ * @brief Timestamps (ns since the log started) of one trip; 0 = not reached.
+ */
+struct TripTimeline {
+    std::uint64_t at[LC_COUNT] = {};
+    int driver = 0, passenger = 0; // person ids, passenger 0 = rowing alone
+    bool driverAdult = false, passengerAdult = false;
+    bool hasPassenger = false;
+};
+
+/**
+ * @class LifecycleLog
+ *
+ * @brief Timelines of all trips of a run.
+ */
+class LifecycleLog {
+public:
+    LifecycleLog() : start(std::chrono::steady_clock::now()) {}
+
+    std::uint64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    void begin_trip(std::uint64_t selectStart, int driver, bool driverAdult, int passenger, bool passengerAdult);
+    void mark(LifecyclePoint p) { if (!trips.empty()) trips.back().at[p] = now(); }
+    void mark(LifecyclePoint p, std::uint64_t at) { if (!trips.empty()) trips.back().at[p] = at; }
+
+    void print(std::ostream &os) const;
+    bool write_events(const std::string &path) const;
+
+    std::vector<TripTimeline> trips;
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+const char* lifecycle_point_name(LifecyclePoint p);
+
+#endif
@@ -0,0 +1,363 @@
+/**
+ * @file src/model.cpp
+ *
+ * @brief Sequential, single-threaded model of the ferrying simulation.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "model.h"
+
+/**
+ * @brief Create the model with everybody on the island.
+ *
+ * @param adults Number of adults.
+ * @param children Number of children.
+ * @param policy Crew selection policy.
+ * @param triage Priority classes and deadlines to hand out.
+ *
+ * @details People are stored adults first, then children, exactly like
+ *          `init_people`, so first-fit selection picks the same people and
+ *          everybody gets the same class and deadline.
+ */
+Ferry::Ferry(int adults, int children, Policy policy, const Triage &triage) : policy(policy) {
+    people.reserve(adults + children);
+    for (int i = 0; i < adults; ++i) {
+        SimPerson p;
+        p.id = i+1;
+        p.isAdult = true;
+        people.push_back(p);
+    }
+    for (int i = 0; i < children; ++i) {
+        SimPerson p;
+        p.id = i+1;
+        p.isAdult = false;
+        people.push_back(p);
+    }
+    adultsOnIsland = adults;
+    childrenOnIsland = children;
+    assign_triage(people, triage);
+    dock = make_waiting_line<SimPerson*>(policy, adults, children);
+    if (dock) for (auto &p : people) dock->arrive(&p);
+}
+
+/**
+ * @brief Add a person to the island while the ferry runs.
+ *
+ * @param person New person; `isAdult`, `priority` and `deadline` are kept.
+ *
+ * @return SimPerson* The person as stored in `people`.
+ *
+ * @details The person gets the next id and waits on the island. Growing
+ *          `people` may move everybody, so pointers from an earlier
+ *          `plan()` must be taken again by index; the waiting line is
+ *          rebuilt in that case.
+ */
+SimPerson* Ferry::join(SimPerson person) {
+    if (people.size() == people.capacity()) requeue(2 * people.size() + 16, nullptr);
+    person.id = static_cast<int>(people.size()) + 1;
+    person.position = ISLAND;
+    person.role = SimPerson::NONE;
+    people.push_back(person);
+    SimPerson* p = &people.back();
+    if (p->isAdult) adultsOnIsland++;
+    else childrenOnIsland++;
+    if (dock) dock->arrive(p);
+    joined = true;
+    return p;
+}
+
+/**
+ * @brief Take a waiting person off the island without the boat.
+ *
+ * @param p Free person on the island (`role == NONE`).
+ *
+ * @return void
+ *
+ * @details The person stays in `people` with role `LEFT`, so no selection
+ *          ever picks them again.
+ */
+void Ferry::leave(SimPerson* p) {
+    if (p->isAdult) adultsOnIsland--;
+    else childrenOnIsland--;
+    requeue(0, p);
+    p->role = SimPerson::LEFT;
+}
+
+/**
+ * @brief Rebuild the waiting line, optionally growing `people` first.
+ *
+ * @param capacity New capacity of `people`, 0 to keep it.
+ * @param without Person to drop from the line, or nullptr.
+ *
+ * @return void
+ *
+ * @details Remembers the line by index, so it survives `people` moving,
+ *          and arrives everybody again in `line_up` order.
+ */
+void Ferry::requeue(std::size_t capacity, const SimPerson* without) {
+    std::vector<std::size_t> order;
+    if (dock) {
+        std::vector<SimPerson*> line;
+        dock->line_up(line);
+        for (SimPerson* p : line)
+            if (p != without) order.push_back(static_cast<std::size_t>(p - people.data()));
+    }
+    if (capacity) people.reserve(capacity);
+    if (!dock) return;
+    dock = make_waiting_line<SimPerson*>(policy, order.size(), order.size());
+    for (std::size_t i : order) dock->arrive(&people[i]);
+}
+
+/**
+ * @brief Return a person found for a crew that could not be completed.
+ *
+ * @param p Person, or nullptr.
+ *
+ * @return void
+ *
+ * @details Same as the threaded `put_back`: only the waiting-line policies
+ *          remove people on a find.
+ */
+void Ferry::put_back(SimPerson* p) {
+    if (dock && p) dock->arrive(p);
+}
+
+/**
+ * @brief Same selection rule as the threaded `find_person`.
+ *
+ * @param wantAdult true for adult, false for child.
+ * @param where Location to search.
+ * @param excludeNeedsBreak whether to exclude those needing a break.
+ *
+ * @return SimPerson* or nullptr if none found.
+ */
+SimPerson* Ferry::find_person(bool wantAdult, Loc where, bool excludeNeedsBreak) {
+    if (dock) return dock->take(wantAdult, where, excludeNeedsBreak);
+    return select_person(people, wantAdult, where, excludeNeedsBreak, policy, cursor);
+}
+
+/**
+ * @brief Second child for a two-child crew, same rule as the threaded `find_partner`.
+ *
+ * @param first Child already chosen as driver.
+ *
+ * @return SimPerson* or nullptr if none found.
+ */
+SimPerson* Ferry::find_partner(const SimPerson* first) {
+    if (dock) return dock->take(false, ISLAND, false, /*preferRested=*/false);
+    return select_partner(people, const_cast<SimPerson*>(first), policy, cursor);
+}
+
+/**
+ * @brief Fill `trip` with a crew leaving from the boat's current side.
+ *
+ * @param trip Trip to fill.
+ * @param driver Person rowing.
+ * @param passenger Optional passenger.
+ *
+ * @return void
+ */
+void Ferry::assign(Trip &trip, SimPerson* driver, SimPerson* passenger) {
+    trip.driver = driver;
+    trip.passenger = passenger;
+    trip.from = location;
+    trip.to = (location == ISLAND ? MAINLAND : ISLAND);
+    driver->role = SimPerson::DRIVER;
+    if (passenger) passenger->role = SimPerson::PASSENGER;
+}
+
+/**
+ * @brief Choose the next crew the way `controller_loop` does.
+ *
+ * @param trip Filled with the chosen crew on success.
+ *
+ * @return true if a trip was planned, false when the simulation is over.
+ *
+ * @details Each stage of the adult cycle maps to one numbered step of
+ *          `controller_loop`; any step that cannot find a crew behaves like
+ *          the `break` in the threaded controller and moves on to the
+ *          children phase. After a `join`, the children phase and the end
+ *          give way to the adult cycle again.
+ */
+bool Ferry::plan(Trip &trip) {
+    // newcomers restart the adult cycle from the boat's side
+    if (joined && (stage == CHILDREN || stage == DONE)) stage = location == ISLAND ? ADULT_PAIR : ADULT_RETURN_AGAIN;
+    joined = false;
+    while (true) {
+        switch (stage) {
+        case ADULT_PAIR: {
+            if (adultsOnIsland == 0) { stage = CHILDREN; break; }
+            SimPerson* c1 = find_person(false, ISLAND, false);
+            SimPerson* c2 = c1 ? find_partner(c1) : nullptr;
+            if (!c1 || !c2) { put_back(c1); stage = CHILDREN; break; }
+            assign(trip, c1, c2);
+            return true;
+        }
+        case ADULT_RETURN:
+        case ADULT_RETURN_AGAIN: {
+            if (stage == ADULT_RETURN_AGAIN && adultsOnIsland == 0 && childrenOnIsland == 0) {
+                stage = CHILDREN;
+                break;
+            }
+            SimPerson* rc = find_person(false, MAINLAND, false);
+            if (!rc) rc = find_person(true, MAINLAND, false);
+            if (!rc) { stage = CHILDREN; break; }
+            assign(trip, rc, nullptr);
+            return true;
+        }
+        case ADULT_WITH_CHILD: {
+            SimPerson* adult = find_person(true, ISLAND, false);
+            SimPerson* child = find_person(false, ISLAND, false);
+            if (!adult || !child) { put_back(adult); put_back(child); stage = CHILDREN; break; }
+            assign(trip, child, adult);
+            return true;
+        }
+        case CHILDREN: {
+            if (childrenOnIsland == 0) { stage = DONE; break; }
+            if (location == MAINLAND) {
+                SimPerson* rc = find_person(false, MAINLAND, false);
+                if (!rc) rc = find_person(true, MAINLAND, false);
+                if (!rc) { stage = DONE; break; }
+                assign(trip, rc, nullptr);
+                return true;
+            }
+            // the row limit is a preference: when every child left needs a
+            // break, one of them rows anyway rather than stranding the rest
+            if (childrenOnIsland >= 2) {
+                SimPerson* c1 = find_person(false, ISLAND, false);
+                SimPerson* c2 = c1 ? find_partner(c1) : nullptr;
+                if (!c1 || !c2) { put_back(c1); stage = DONE; break; }
+                assign(trip, c1, c2);
+                return true;
+            }
+            SimPerson* c = find_person(false, ISLAND, false);
+            if (!c) { stage = DONE; break; }
+            assign(trip, c, nullptr);
+            return true;
+        }
+        case DONE:
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Apply the driver's post-trip bookkeeping from `Person::run`.
+ *
+ * @param trip Trip returned by the last `plan()`.
+ * @param departedAt Virtual time at which the trip left.
+ * @param arrivedAt Virtual time at which it landed.
+ *
+ * @return void
+ */
+void Ferry::finish(const Trip &trip, double departedAt, double arrivedAt) {
+    location = trip.to;
+
+    auto movePerson = [&](SimPerson* p) {
+        if (!p) return;
+        if (trip.from == ISLAND) {
+            if (p->isAdult) adultsOnIsland--;
+            else childrenOnIsland--;
+            p->position = MAINLAND;
+            p->lastDeparture = departedAt;
+            p->landedAt = arrivedAt;
+        } else {
+            if (p->isAdult) adultsOnIsland++;
+            else childrenOnIsland++;
+            p->position = ISLAND;
+        }
+    };
+    movePerson(trip.driver);
+    movePerson(trip.passenger);
+
+    if (trip.from == ISLAND) tripsToMain++; else tripsToIsland++;
+
+    if (trip.passenger) {
+        if (!trip.driver->isAdult && !trip.passenger->isAdult) twokidBoats++;
+        else kidAdultBoats++;
+    } else {
+        soloBoats++;
+    }
+    if (trip.driver->isAdult) adultDrivers++; else childDrivers++;
+
+    trip.driver->consecutiveRows++;
+    if (trip.driver->consecutiveRows >= MAX_CONSECUTIVE) trip.driver->needsBreak = true;
+    if (trip.passenger) {
+        trip.passenger->consecutiveRows = 0;
+        trip.passenger->needsBreak = false;
+    }
+
+    trip.driver->role = SimPerson::NONE;
+    if (trip.passenger) trip.passenger->role = SimPerson::NONE;
+    if (dock) {
+        dock->arrive(trip.driver);
+        if (trip.passenger) dock->arrive(trip.passenger);
+    }
+
+    switch (stage) {
+    case ADULT_PAIR: stage = ADULT_RETURN; break;
+    case ADULT_RETURN: stage = ADULT_WITH_CHILD; break;
+    case ADULT_WITH_CHILD: stage = ADULT_RETURN_AGAIN; break;
+    case ADULT_RETURN_AGAIN: stage = ADULT_PAIR; break;
+    default: break;
+    }
+}
+
+/**
+ * @brief Run one complete replica of the model in virtual time.
+ *
+ * @param adults Number of adults.
+ * @param children Number of children.
+ * @param seed Seed of the replica's trip-time stream.
+ * @param policy Crew selection policy.
+ * @param triage Priority classes and deadlines; its seed is replaced by `seed`.
+ *
+ * @return ReplicaResult Makespan, per-person waits, deadline misses and whether it stalled.
+ *
+ * @details Trip times are drawn from a `std::mt19937` with the same
+ *          1–4 second distribution as `Boat::tripTime`, in trip order.
+ *          Classes and deadlines are drawn from the replica seed too, so
+ *          every policy compared on a replica sees the same people.
+ */
+ReplicaResult simulate_replica(int adults, int children, std::mt19937::result_type seed,
+                               Policy policy, Triage triage) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist{1,4};
+
+    triage.seed = seed;
+    Ferry ferry(adults, children, policy, triage);
+    ReplicaResult r;
+    Trip trip;
+    while (ferry.plan(trip)) {
+        long t = dist(rng);
+        ferry.finish(trip, static_cast<double>(r.makespan), static_cast<double>(r.makespan + t));
+        r.makespan += t;
+        r.trips++;
+    }
+    r.stalled = ferry.stalled();
+    r.waits.reserve(ferry.people.size());
+    for (auto &p : ferry.people) r.waits.push_back(static_cast<long>(p.lastDeparture));
+    r.deadlineMisses = deadline_misses(ferry.people);
+    return r;
+}
+
+/**
+ * @brief Derive an independent seed for replica `index` from a base seed.
+ *
+ * @param base User supplied base seed.
+ * @param index Replica number.
+ *
+ * @return std::mt19937::result_type Seed for that replica's trip-time stream.
+ *
+ * @details Uses the SplitMix64 finalizer so neighbouring indices map to
+ *          unrelated seeds; the result is deterministic for a given base.
+ */
+std::mt19937::result_type replica_seed(std::uint64_t base, std::uint64_t index) {
+    std::uint64_t z = base + 0x9E3779B97F4A7C15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<std::mt19937::result_type>(z ^ (z >> 32));
+}
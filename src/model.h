@@ -0,0 +1,134 @@
+/**
+ * @file src/model.h
+ *
+ * @brief Sequential, single-threaded model of the ferrying simulation.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * `Ferry` replays the decisions of `controller_loop` and the post-trip
+ * bookkeeping of `Person::run` without any threads. Time is virtual: the
+ * caller draws each trip time and advances its own clock, so one replica of
+ * the simulation costs microseconds instead of minutes.
+ *
+ * The open system (`opensys.h`) also lets people `join` the island and
+ * `leave` it while the ferry runs. A join after the controller finished or
+ * fell back to the children phase restarts the adult cycle at the next
+ * `plan()`, so newcomers are ferried by the same crew steps.
+ */
+
+#ifndef MODEL_H
+#define MODEL_H
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "island.h"
+#include "policy.h"
+#include "triage.h"
+
+/**
+ * @struct SimPerson
+ *
+ * @brief Per-person state tracked by the model (the data part of `Person`).
+ */
+struct SimPerson {
+    int id = 0;
+    bool isAdult = false;
+    Loc position = ISLAND;
+    int consecutiveRows = 0;
+
+    // LEFT: gone from the island without the boat (open-system shedding)
+    enum Role { NONE, DRIVER, PASSENGER, LEFT } role = NONE;
+    bool needsBreak = false;
+
+    // virtual time at which this person last left the island
+    double lastDeparture = 0;
+
+    // triage (see triage.h): class, deadline and last landing on the mainland
+    int priority = 0;
+    double deadline = 0;
+    double landedAt = 0;
+};
+
+/**
+ * @struct Trip
+ *
+ * @brief One boat crossing chosen by the controller.
+ */
+struct Trip {
+    SimPerson* driver = nullptr;
+    SimPerson* passenger = nullptr;
+    Loc from = ISLAND;
+    Loc to = MAINLAND;
+};
+
+/**
+ * @class Ferry
+ *
+ * @brief State machine equivalent of `controller_loop` plus the boat state.
+ *
+ * Call `plan()` to get the next crew, then `finish()` once its trip is over.
+ * `plan()` returns false when everybody is on the mainland or when the
+ * controller would have stopped with people left behind (`stalled()`).
+ */
+class Ferry {
+public:
+    Ferry(int adults, int children, Policy policy = Policy::FIRST_FIT, const Triage &triage = {});
+
+    bool plan(Trip &trip);
+    void finish(const Trip &trip, double departedAt, double arrivedAt);
+
+    SimPerson* join(SimPerson person);
+    void leave(SimPerson* p);
+
+    bool done() const { return stage == DONE; }
+    bool stalled() const { return stage == DONE && (adultsOnIsland > 0 || childrenOnIsland > 0); }
+
+    std::vector<SimPerson> people;
+    Loc location = ISLAND;
+    int adultsOnIsland = 0;
+    int childrenOnIsland = 0;
+
+    // stats (same meaning as the fields of Boat)
+    int tripsToMain = 0, tripsToIsland = 0;
+    int twokidBoats = 0, kidAdultBoats = 0, soloBoats = 0;
+    int adultDrivers = 0, childDrivers = 0;
+
+private:
+    enum Stage { ADULT_PAIR, ADULT_RETURN, ADULT_WITH_CHILD, ADULT_RETURN_AGAIN, CHILDREN, DONE };
+    Stage stage = ADULT_PAIR;
+    Policy policy;
+    std::size_t cursor = 0;
+    std::unique_ptr<WaitingLine<SimPerson*>> dock; // fifo, priority and edf policies only
+    bool joined = false; // someone joined since the last plan()
+
+    SimPerson* find_person(bool wantAdult, Loc where, bool excludeNeedsBreak = true);
+    SimPerson* find_partner(const SimPerson* first);
+    void put_back(SimPerson* p);
+    void assign(Trip &trip, SimPerson* driver, SimPerson* passenger);
+    void requeue(std::size_t capacity, const SimPerson* without);
+};
+
+/**
+ * @struct ReplicaResult
+ *
+ * @brief Outcome of one virtual-time run of the model.
+ */
+struct ReplicaResult {
+    long makespan = 0;          // virtual seconds until the last trip ended
+    std::vector<long> waits;    // per person: time of their final departure from the island
+    int trips = 0;
+    bool stalled = false;
+    long deadlineMisses = 0;    // people who landed after their deadline
+};
+
+ReplicaResult simulate_replica(int adults, int children, std::mt19937::result_type seed,
+                               Policy policy = Policy::FIRST_FIT, Triage triage = {});
+std::mt19937::result_type replica_seed(std::uint64_t base, std::uint64_t index);
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file src/mpmc.h
+ *
+ * @brief Bounded lock-free multi-producer multi-consumer ring.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence number
+ * that says whose turn it is: a producer may fill cell `pos` when its
+ * sequence equals `pos`, a consumer may empty it when it equals `pos + 1`.
+ * Producers and consumers claim positions with one CAS on `tail` or `head`
+ * and never wait for each other, except that a full ring rejects a push and
+ * an empty ring rejects a pop.
+ */
+
+#ifndef MPMC_H
+#define MPMC_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class MpmcQueue
+ *
+ * @brief Fixed-capacity FIFO; the capacity is rounded up to a power of two.
+ */
+template <class T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(std::size_t capacity) {
+        std::size_t n = 2;
+        while (n < capacity) n <<= 1;
+        mask = n - 1;
+        cells.reset(new Cell[n]);
+        for (std::size_t i = 0; i < n; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    /**
+     * @brief Append an item.
+     *
+     * @param x Item.
+     *
+     * @return bool false if the ring is full.
+     */
+    bool try_push(const T &x) {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell &c = cells[pos & mask];
+            std::size_t seq = c.seq.load(std::memory_order_acquire);
+            std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (dif == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.data = x;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the oldest item.
+     *
+     * @param out Output item.
+     *
+     * @return bool false if the ring is empty.
+     */
+    bool try_pop(T &out) {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+        while (true) {
+            Cell &c = cells[pos & mask];
+            std::size_t seq = c.seq.load(std::memory_order_acquire);
+            std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = c.data;
+                    c.seq.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of items, exact only while nobody is pushing or popping.
+     *
+     * @return std::size_t Items.
+     */
+    std::size_t size() const {
+        std::size_t t = tail.load(std::memory_order_acquire), h = head.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask = 0;
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+};
+
+#endif
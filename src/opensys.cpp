@@ -0,0 +1,291 @@
+/**
+ * @file src/opensys.cpp
+ *
+ * @brief Open-system run: people keep arriving, shores have a capacity.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "opensys.h"
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "model.h"
+#include "stats.h"
+
+static const double NEVER = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Command line name of an admission policy.
+ *
+ * @param a Policy.
+ *
+ * @return const char* Name accepted by `parse_admission`.
+ */
+const char* admission_name(Admission a) {
+    switch (a) {
+    case Admission::REJECT: return "reject";
+    case Admission::DELAY: return "delay";
+    case Admission::SHED: return "shed";
+    }
+    return "?";
+}
+
+/**
+ * @brief Parse an admission policy name.
+ *
+ * @param name Name as printed by `admission_name`.
+ * @param out Parsed policy (filled on success).
+ *
+ * @return true if the name is known.
+ */
+bool parse_admission(const std::string &name, Admission &out) {
+    for (Admission a : {Admission::REJECT, Admission::DELAY, Admission::SHED}) {
+        if (name == admission_name(a)) { out = a; return true; }
+    }
+    return false;
+}
+
+/**
+ * @struct Arrival
+ *
+ * @brief One person on the way to the island (or held back by the source).
+ */
+struct Arrival {
+    double arrived;
+    long seq;
+    SimPerson person; // age, class and deadline (relative to `arrived`)
+};
+
+/**
+ * @class ArrivalSource
+ *
+ * @brief The initial population followed by a Poisson process that can be paused.
+ */
+class ArrivalSource {
+public:
+    ArrivalSource(const OpenConfig &cfg, std::mt19937 &rng) : rng(rng), gap(cfg.rate > 0 ? cfg.rate : 1.0),
+                                                             rate(cfg.rate), end(cfg.duration), triage(cfg.triage) {
+        int total = cfg.adults + cfg.children;
+        adultShare = total > 0 ? static_cast<double>(cfg.adults) / total : 0.5;
+        triage.seed = cfg.seed;
+        for (int i = 0; i < total; ++i) initial.push_back(make(0, i < cfg.adults));
+        next = rate > 0 ? gap(rng) : NEVER;
+    }
+
+    // time of the next arrival, NEVER when exhausted or held back
+    double peek() const {
+        if (held) return NEVER;
+        if (!initial.empty()) return 0;
+        return next < end ? next : NEVER;
+    }
+
+    Arrival take() {
+        if (!initial.empty()) {
+            Arrival a = initial.front();
+            initial.pop_front();
+            return a;
+        }
+        bool adult = std::uniform_real_distribution<double>(0, 1)(rng) < adultShare;
+        Arrival a = make(next, adult);
+        next += gap(rng);
+        return a;
+    }
+
+    // backpressure: keep `a` until `release()`
+    void hold(const Arrival &a) { held = true; pending = a; }
+    bool holding() const { return held; }
+    const Arrival &waiting() const { return pending; }
+    Arrival release(double now) {
+        held = false;
+        // the paused Poisson process resumes where it stopped
+        if (initial.empty() && next < now) next = now + gap(rng);
+        return pending;
+    }
+
+private:
+    Arrival make(double at, bool adult) {
+        Arrival a{at, seq, SimPerson{}};
+        a.person.isAdult = adult;
+        triage_person(&a.person, triage, static_cast<std::size_t>(seq++));
+        return a;
+    }
+
+    std::mt19937 &rng;
+    std::exponential_distribution<double> gap;
+    double rate, end, next, adultShare;
+    Triage triage;
+    long seq = 0;
+    std::deque<Arrival> initial;
+    bool held = false;
+    Arrival pending{};
+};
+
+/**
+ * @brief Run the open system and print its summary.
+ *
+ * @param cfg Initial population, arrival rate and duration, capacity, admission, policy, triage and seed.
+ * @param trips Output: boat crossings.
+ *
+ * @return int 0.
+ *
+ * @details Latency runs from a person's first arrival (including time held
+ *          back by backpressure) until their last landing on the mainland,
+ *          since a child who reached it may still be sent back as a rower.
+ */
+int run_open_system(const OpenConfig &cfg, long &trips) {
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(cfg.seed));
+    std::uniform_int_distribution<int> dist{1,4};
+    ArrivalSource source(cfg, rng);
+    Ferry ferry(0, 0, cfg.policy);
+    std::vector<double> since; // arrival time, by index in `ferry.people`
+    const int classes = std::max(1, cfg.triage.classes);
+
+    long offered = 0, admitted = 0, deferred = 0, peak = 0;
+    std::vector<long> rejected(classes), shed(classes);
+    double deferral = 0, heldSince = 0, blocked = 0, busy = 0;
+    double now = 0, departed = 0, landsAt = NEVER, last = 0;
+    std::ptrdiff_t driver = -1, passenger = -1; // crew of the crossing under way
+    Trip trip;
+    trips = 0;
+
+    auto shore = [&] { return static_cast<long>(ferry.adultsOnIsland + ferry.childrenOnIsland); };
+    // while the boat is away from the island a rower is due back, and rowers
+    // always land, so their place is kept free to make the capacity hold
+    auto room = [&] {
+        bool away = ferry.location == MAINLAND || (landsAt != NEVER && trip.from == ISLAND);
+        return cfg.capacity == 0 || shore() + (away ? 1 : 0) < cfg.capacity;
+    };
+    auto admit = [&](const Arrival &a) {
+        SimPerson p = a.person;
+        if (p.deadline > 0) p.deadline += a.arrived;
+        ferry.join(p);
+        since.push_back(a.arrived);
+        admitted++;
+        peak = std::max(peak, shore());
+    };
+    auto offer = [&](const Arrival &a) {
+        offered++;
+        if (room()) { admit(a); return; }
+        switch (cfg.admission) {
+        case Admission::REJECT:
+            rejected[a.person.priority]++;
+            break;
+        case Admission::DELAY:
+            source.hold(a);
+            deferred++;
+            heldSince = now;
+            break;
+        case Admission::SHED: {
+            // drop the longest-waiting free person of the lowest class: their
+            // wait is already the worst, and newer ones still have a chance
+            SimPerson* lowest = nullptr;
+            for (SimPerson &p : ferry.people) {
+                if (p.position != ISLAND || p.role != SimPerson::NONE) continue;
+                if (!lowest || p.priority > lowest->priority) lowest = &p;
+            }
+            if (lowest && lowest->priority > a.person.priority) {
+                shed[lowest->priority]++;
+                ferry.leave(lowest);
+                admit(a);
+            } else {
+                rejected[a.person.priority]++;
+            }
+            break;
+        }
+        }
+    };
+
+    while (true) {
+        if (landsAt == NEVER && ferry.plan(trip)) {
+            // the crew leaves now; remember it by index, joins may move people
+            driver = trip.driver - ferry.people.data();
+            passenger = trip.passenger ? trip.passenger - ferry.people.data() : -1;
+            departed = now;
+            landsAt = now + dist(rng);
+        }
+        double tArrive = source.peek();
+        if (tArrive == NEVER && landsAt == NEVER) break;
+
+        if (landsAt <= tArrive) {
+            now = landsAt;
+            trip.driver = &ferry.people[static_cast<std::size_t>(driver)];
+            trip.passenger = passenger >= 0 ? &ferry.people[static_cast<std::size_t>(passenger)] : nullptr;
+            ferry.finish(trip, departed, now);
+            peak = std::max(peak, shore());
+            trips++;
+            busy += now - departed;
+            last = now;
+            landsAt = NEVER;
+
+            if (source.holding() && room()) {
+                blocked += now - heldSince;
+                Arrival held = source.release(now);
+                deferral += now - held.arrived;
+                admit(held);
+            }
+        } else {
+            now = tArrive;
+            offer(source.take());
+        }
+    }
+    // an arrival still held when the boat can do no more is turned away
+    if (source.holding()) rejected[source.waiting().person.priority]++;
+
+    long rejectedTotal = 0, shedTotal = 0, served = 0, stranded = 0;
+    for (int c = 0; c < classes; ++c) { rejectedTotal += rejected[c]; shedTotal += shed[c]; }
+    std::vector<double> latency;
+    std::vector<std::vector<double>> byClass(classes);
+    for (std::size_t i = 0; i < ferry.people.size(); ++i) {
+        const SimPerson &p = ferry.people[i];
+        if (p.role == SimPerson::LEFT) continue;
+        if (p.position == ISLAND) { stranded++; continue; }
+        served++;
+        latency.push_back(p.landedAt - since[i]);
+        byClass[p.priority].push_back(p.landedAt - since[i]);
+    }
+
+    std::cout << "Open System Summary" << std::endl;
+    std::cout << "Arrivals: " << cfg.rate << "/s for " << cfg.duration << " s after " << cfg.adults << " adults and "
+              << cfg.children << " children, capacity: ";
+    if (cfg.capacity) std::cout << cfg.capacity;
+    else std::cout << "unbounded";
+    std::cout << ", admission: " << admission_name(cfg.admission) << ", policy: " << policy_name(cfg.policy)
+              << ", seed: " << cfg.seed << std::endl;
+    std::cout << "Offered: " << offered << ", admitted: " << admitted << ", served: " << served
+              << ", stranded: " << stranded << ", rejected: " << rejectedTotal << ", shed: " << shedTotal
+              << ", deferred: " << deferred << std::endl;
+    if (rejectedTotal || shedTotal) {
+        std::cout << "By class (rejected/shed):";
+        for (int c = 0; c < classes; ++c) std::cout << " " << c << ": " << rejected[c] << "/" << shed[c];
+        std::cout << std::endl;
+    }
+    std::cout << "Crossings: " << trips << " (" << ferry.twokidBoats << " two-child, " << ferry.kidAdultBoats
+              << " child+adult, " << ferry.soloBoats << " solo)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    if (deferred) {
+        std::cout << "Backpressure: source held back " << blocked << " s (" << (last > 0 ? 100 * blocked / last : 0)
+                  << "% of the run), mean deferral " << deferral / deferred << " s" << std::endl;
+    }
+    std::cout << "Peak shore: " << peak << " people, boat busy " << (last > 0 ? 100 * busy / last : 0)
+              << "%, last crossing ended at " << last << " s" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    if (cfg.triage.deadline > 0) {
+        std::cout << "Deadline misses: " << deadline_misses(ferry.people) << " (stranded and shed included)"
+                  << std::endl;
+    }
+    print_summary_line(std::cout, "Latency (s)", summarize(latency));
+    for (int c = 0; c < classes && classes > 1; ++c) {
+        if (byClass[c].empty()) continue;
+        std::string label = "Latency class " + std::to_string(c) + " (s)";
+        print_summary_line(std::cout, label.c_str(), summarize(byClass[c]));
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file src/opensys.h
+ *
+ * @brief Open-system run: people keep arriving, shores have a capacity.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The other modes evacuate a fixed population. `--arrival-rate` instead runs
+ * an open system in virtual time. The island starts with `<adults>
+ * <children>` waiting, more people arrive as a Poisson process for
+ * `duration` seconds, and the boat keeps ferrying until nobody it can carry
+ * is left. Each arrival is an adult with the share of adults in the starting
+ * population. Arrivals `join` a sequential `Ferry`, so the crews are those
+ * of `controller_loop`: the adult cycle, two-child crews, a rower back for
+ * every crossing and the `MAX_CONSECUTIVE` limit, with the chosen crew
+ * selection policy. Adults left on the island with no child to row them
+ * stay stranded, as in the closed runs.
+ *
+ * Classes and deadlines come from `--priority-classes` and `--deadline`
+ * (`triage.h`), drawn from each arrival's sequence number; a deadline
+ * counts from the person's arrival. The `priority` and `edf` policies serve
+ * by them. The island shore holds at most `capacity` people (0 =
+ * unbounded), and an arrival at a full shore is handled by the admission
+ * policy:
+ *
+ * - reject: the arrival is turned away.
+ * - delay: backpressure. The arrival stays with the source, which stops
+ *   producing until the boat frees a place; the person's latency still
+ *   counts from when they first arrived.
+ * - shed: the longest-waiting free person of the lowest class leaves the
+ *   island if the arrival has a strictly higher class; otherwise the
+ *   arrival is turned away. With a single class nobody is ever shed.
+ *
+ * The shore counts everyone on the island, including crew children rowed
+ * back, who always land. While the boat is away from the island one place
+ * is kept for the rower due back, so the shore never exceeds the capacity.
+ * With any capacity the shore, and so memory and waiting time, stay bounded
+ * however far the arrival rate exceeds the boat's service rate.
+ */
+
+#ifndef OPENSYS_H
+#define OPENSYS_H
+
+#include <cstdint>
+#include <string>
+
+#include "policy.h"
+#include "triage.h"
+
+/**
+ * @enum Admission
+ *
+ * @brief What happens to an arrival at a full shore.
+ */
+enum class Admission { REJECT, DELAY, SHED };
+
+const char* admission_name(Admission a);
+bool parse_admission(const std::string &name, Admission &out);
+
+/**
+ * @struct OpenConfig
+ *
+ * @brief What to run in `--arrival-rate` mode.
+ */
+struct OpenConfig {
+    int adults = 0;         // waiting on the island at t = 0
+    int children = 0;
+    double rate = 0;        // arrivals per second
+    double duration = 3600; // seconds of arrivals
+    long capacity = 0;      // waiting people the island holds, 0 = unbounded
+    Admission admission = Admission::REJECT;
+    Policy policy = Policy::FIRST_FIT;
+    Triage triage;          // classes and deadlines; its seed is replaced by `seed`
+    std::uint64_t seed = 0;
+};
+
+int run_open_system(const OpenConfig &cfg, long &trips);
+
+#endif
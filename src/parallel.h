@@ -0,0 +1,58 @@
+/**
+ * @file src/parallel.h
+ *
+ * @brief Minimal fork-join helpers for running independent replicas on all cores.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Number of worker threads to use.
+ *
+ * @param requested Requested count, 0 meaning one per hardware thread.
+ *
+ * @return unsigned At least one.
+ */
+inline unsigned worker_count(unsigned requested) {
+    if (requested) return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+/**
+ * @brief Run `fn(i, worker)` for every i in [0, count) across worker threads.
+ *
+ * @param count Number of items.
+ * @param workers Number of threads (the caller is worker 0).
+ * @param fn Work function; must only write state owned by item `i` or worker `worker`.
+ * @param chunk Items claimed per atomic increment.
+ *
+ * @return void
+ */
+template <typename Fn>
+void parallel_for(long count, unsigned workers, Fn fn, long chunk = 64) {
+    std::atomic<long> next{0};
+    auto work = [&](unsigned w) {
+        while (true) {
+            long begin = next.fetch_add(chunk);
+            if (begin >= count) return;
+            long end = std::min(count, begin + chunk);
+            for (long i = begin; i < end; ++i) fn(i, w);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (auto &t : pool) t.join();
+}
+
+#endif
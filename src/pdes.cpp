@@ -0,0 +1,434 @@
+/**
+ * @file src/pdes.cpp
+ *
+ * @brief Multi-island virtual-time world, sequential or as a conservative PDES.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "pdes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "model.h"
+#include "stats.h"
+
+static const long NEVER = std::numeric_limits<long>::max();
+static const long LOOKAHEAD = 1; // minimum trip time and the dock turnaround
+
+/**
+ * @enum EventKind
+ *
+ * @brief Events of the world; the order breaks ties at equal timestamps.
+ *
+ * - EV_RELEASE (mainland): a boat leaves its berth.
+ * - EV_DOCK (mainland): a boat reaches the mainland and asks for a berth.
+ * - EV_LEAVE (island): a boat leaves the mainland; its island plans the return.
+ * - EV_HOME (island): a boat is back at its island (or starts there at t = 0).
+ */
+enum EventKind { EV_RELEASE, EV_DOCK, EV_LEAVE, EV_HOME };
+
+/**
+ * @struct Event
+ *
+ * @brief One timestamped event (or message between LPs).
+ */
+struct Event {
+    long time;
+    int kind;
+    int island;
+    bool last; // EV_DOCK: this trip empties the island
+
+    bool operator>(const Event &o) const {
+        if (time != o.time) return time > o.time;
+        if (kind != o.kind) return kind > o.kind;
+        return island > o.island;
+    }
+};
+
+using EventQueue = std::priority_queue<Event, std::vector<Event>, std::greater<Event>>;
+
+/**
+ * @struct IslandState
+ *
+ * @brief One island: its ferry and trip-time stream (owned by its LP).
+ */
+struct IslandState {
+    IslandState(int adults, int children, Policy policy, std::mt19937::result_type seed)
+        : ferry(adults, children, policy), rng(seed) {}
+
+    Ferry ferry;
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> dist{1,4};
+    long trips = 0;
+    bool stalled = false;
+};
+
+/**
+ * @struct Dock
+ *
+ * @brief One mainland dock: its free berths and the boats waiting for one.
+ */
+struct Dock {
+    int freeBerths = 0;
+    std::deque<Event> waiting;     // EV_DOCK events in arrival order
+    std::vector<double> waits;     // every docking's wait, in grant order
+};
+
+/**
+ * @struct World
+ *
+ * @brief All islands plus the mainland docks, and the event handlers.
+ *
+ * The handlers only touch the island of the event (island kinds) or that
+ * island's dock (mainland kinds), so LPs owning disjoint islands and docks
+ * can run them concurrently. New events go to `out`; the driver routes them.
+ */
+struct World {
+    World(const PdesConfig &cfg) : docks(cfg.docks), makespan(cfg.islands, 0),
+                                   waitTotal(cfg.islands, 0), dockings(cfg.islands, 0) {
+        islands.reserve(cfg.islands);
+        for (int i = 0; i < cfg.islands; ++i)
+            islands.emplace_back(cfg.adults, cfg.children, cfg.policy, replica_seed(cfg.seed, i));
+        // the berths are split as evenly as possible
+        for (int d = 0; d < cfg.docks; ++d) {
+            docks[d].freeBerths = static_cast<int>(static_cast<long>(cfg.berths) * (d + 1) / cfg.docks -
+                                                   static_cast<long>(cfg.berths) * d / cfg.docks);
+        }
+    }
+
+    /**
+     * @brief Dock island `i` lands at: the islands are split into `docks.size()` contiguous ranges.
+     *
+     * @param island Island.
+     *
+     * @return int Dock.
+     */
+    int dock_of(int island) const {
+        return static_cast<int>(static_cast<long>(island) * static_cast<long>(docks.size()) /
+                                static_cast<long>(islands.size()));
+    }
+
+    void handle(const Event &e, std::vector<Event> &out);
+    void grant(Dock &dock, int island, long arrived, bool last, long at, std::vector<Event> &out);
+    void depart(int island, long at, std::vector<Event> &out);
+
+    // island side
+    std::vector<IslandState> islands;
+
+    // mainland side
+    std::vector<Dock> docks;
+    std::vector<long> makespan;    // per island: when its last boatload docked
+    std::vector<long> waitTotal;   // per island: seconds spent waiting for a berth
+    std::vector<long> dockings;    // per island
+};
+
+/**
+ * @brief Plan, draw and book island `i`'s next crossing, departing at `at`.
+ *
+ * @param island Island.
+ * @param at Departure time.
+ * @param out New events.
+ *
+ * @return void
+ *
+ * @details The ferry's bookkeeping does not depend on time, so the trip is
+ *          finished right away and only its arrival is scheduled.
+ */
+void World::depart(int island, long at, std::vector<Event> &out) {
+    IslandState &s = islands[island];
+    Trip trip;
+    if (!s.ferry.plan(trip)) {
+        s.stalled = s.ferry.stalled();
+        return;
+    }
+    long arrive = at + s.dist(s.rng);
+    s.ferry.finish(trip, static_cast<double>(at), static_cast<double>(arrive));
+    s.trips++;
+    if (trip.to == MAINLAND) {
+        bool last = s.ferry.adultsOnIsland == 0 && s.ferry.childrenOnIsland == 0;
+        out.push_back({arrive, EV_DOCK, island, last});
+    } else {
+        out.push_back({arrive, EV_HOME, island, false});
+    }
+}
+
+/**
+ * @brief Give island `i`'s boat a berth of its dock at time `at`.
+ *
+ * @param dock The island's dock.
+ * @param island Island.
+ * @param arrived When the boat reached the mainland.
+ * @param last Whether this boatload emptied the island.
+ * @param at Grant time.
+ * @param out New events.
+ *
+ * @return void
+ */
+void World::grant(Dock &dock, int island, long arrived, bool last, long at, std::vector<Event> &out) {
+    dock.freeBerths--;
+    waitTotal[island] += at - arrived;
+    dockings[island]++;
+    dock.waits.push_back(static_cast<double>(at - arrived));
+    out.push_back({at + LOOKAHEAD, EV_RELEASE, island, false});
+    if (last) makespan[island] = at;
+    else out.push_back({at + LOOKAHEAD, EV_LEAVE, island, false});
+}
+
+/**
+ * @brief Handle one event.
+ *
+ * @param e Event.
+ * @param out New events (all at least `LOOKAHEAD` later than `e`).
+ *
+ * @return void
+ */
+void World::handle(const Event &e, std::vector<Event> &out) {
+    switch (e.kind) {
+    case EV_RELEASE: {
+        Dock &dock = docks[dock_of(e.island)];
+        dock.freeBerths++;
+        if (!dock.waiting.empty()) {
+            Event next = dock.waiting.front();
+            dock.waiting.pop_front();
+            grant(dock, next.island, next.time, next.last, e.time, out);
+        }
+        break;
+    }
+    case EV_DOCK: {
+        Dock &dock = docks[dock_of(e.island)];
+        if (dock.freeBerths > 0) grant(dock, e.island, e.time, e.last, e.time, out);
+        else dock.waiting.push_back(e);
+        break;
+    }
+    case EV_LEAVE:
+    case EV_HOME:
+        depart(e.island, e.time, out);
+        break;
+    }
+}
+
+/**
+ * @class Barrier
+ *
+ * @brief Reusable barrier for a fixed number of threads (C++17 has none).
+ */
+class Barrier {
+public:
+    explicit Barrier(int n) : count(n), left(n) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lk(mtx);
+        long gen = generation;
+        if (--left == 0) {
+            left = count;
+            generation++;
+            cv.notify_all();
+            return;
+        }
+        cv.wait(lk, [&]{ return generation != gen; });
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    int count, left;
+    long generation = 0;
+};
+
+/**
+ * @struct LogicalProcess
+ *
+ * @brief One LP: its event queue, its outgoing messages and its clock.
+ */
+struct LogicalProcess {
+    EventQueue queue;
+    std::vector<std::vector<Event>> outbox; // by destination LP
+    long next = NEVER;                      // earliest pending event, published at the barrier
+    long events = 0, dockEvents = 0;
+};
+
+/**
+ * @brief Counters of one run of either engine.
+ */
+struct PdesStats {
+    long events = 0;
+    long mainlandEvents = 0;
+    long windows = 0;
+    long busiest = 0; // events of the busiest LP, which bounds the speedup
+};
+
+/**
+ * @brief Run the world with one global event queue.
+ *
+ * @param w World.
+ * @param stats Output counters.
+ *
+ * @return void
+ */
+static void run_sequential(World &w, PdesStats &stats) {
+    EventQueue queue;
+    for (int i = 0; i < static_cast<int>(w.islands.size()); ++i) queue.push({0, EV_HOME, i, false});
+    std::vector<Event> out;
+    while (!queue.empty()) {
+        Event e = queue.top();
+        queue.pop();
+        out.clear();
+        w.handle(e, out);
+        for (auto &o : out) queue.push(o);
+        stats.events++;
+        if (e.kind <= EV_DOCK) stats.mainlandEvents++;
+    }
+}
+
+/**
+ * @brief Run the world as `lps` LPs, one thread each.
+ *
+ * @param w World.
+ * @param lps LPs (island i belongs to LP i * lps / islands).
+ * @param stats Output counters.
+ *
+ * @return void
+ *
+ * @details Each dock belongs to the LP of its first island, so when the
+ *          docks are no coarser than the LPs, most dock messages stay on
+ *          the LP that sent them. Each window: publish the earliest pending
+ *          time, agree on the global minimum T, process every event before
+ *          T + LOOKAHEAD, then hand messages over. Messages are never for
+ *          the current window, so their delivery after the second barrier
+ *          is in time.
+ */
+static void run_parallel(World &w, unsigned lps, PdesStats &stats) {
+    int islands = static_cast<int>(w.islands.size());
+    auto lp_of = [&](int island) { return static_cast<int>(static_cast<long>(island) * lps / islands); };
+    std::vector<int> dockLp(w.docks.size(), 0);
+    for (int i = islands - 1; i >= 0; --i) dockLp[w.dock_of(i)] = lp_of(i);
+    auto owner = [&](const Event &e) {
+        return e.kind <= EV_DOCK ? dockLp[w.dock_of(e.island)] : lp_of(e.island);
+    };
+
+    std::vector<LogicalProcess> lp(lps);
+    for (auto &p : lp) p.outbox.resize(lps);
+    for (int i = 0; i < islands; ++i) lp[owner({0, EV_HOME, i, false})].queue.push({0, EV_HOME, i, false});
+
+    Barrier barrier(static_cast<int>(lps));
+    auto run = [&](int self) {
+        LogicalProcess &me = lp[self];
+        std::vector<Event> out;
+        while (true) {
+            me.next = me.queue.empty() ? NEVER : me.queue.top().time;
+            barrier.wait();
+            long T = NEVER;
+            for (auto &p : lp) T = std::min(T, p.next);
+            if (T == NEVER) break;
+            if (self == 0) stats.windows++;
+
+            while (!me.queue.empty() && me.queue.top().time < T + LOOKAHEAD) {
+                Event e = me.queue.top();
+                me.queue.pop();
+                out.clear();
+                w.handle(e, out);
+                me.events++;
+                if (e.kind <= EV_DOCK) me.dockEvents++;
+                for (auto &o : out) {
+                    int dst = owner(o);
+                    if (dst == self) me.queue.push(o);
+                    else me.outbox[dst].push_back(o);
+                }
+            }
+            barrier.wait();
+
+            for (auto &p : lp) {
+                for (auto &e : p.outbox[self]) me.queue.push(e);
+                p.outbox[self].clear();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int p = 1; p < static_cast<int>(lps); ++p) threads.emplace_back(run, p);
+    run(0);
+    for (auto &t : threads) t.join();
+
+    for (auto &p : lp) {
+        stats.events += p.events;
+        stats.mainlandEvents += p.dockEvents;
+        stats.busiest = std::max(stats.busiest, p.events);
+    }
+}
+
+/**
+ * @brief Run the multi-island world and print its summary.
+ *
+ * @param cfg Islands, population per island, berths, seed, policy and LP count.
+ * @param trips Output: trips made by all boats.
+ *
+ * @return int 0 on success, 1 if every island stalled.
+ *
+ * @details The digest is an FNV-1a hash of every island's trips, makespan
+ *          and total berth wait; equal digests mean equal results.
+ */
+int run_pdes(const PdesConfig &cfg, long &trips) {
+    World w(cfg);
+    PdesStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    if (cfg.lps == 0) run_sequential(w, stats);
+    else run_parallel(w, cfg.lps, stats);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::uint64_t digest = 1469598103934665603ULL;
+    auto mix = [&](long v) {
+        for (int b = 0; b < 8; ++b) {
+            digest ^= static_cast<std::uint64_t>(v >> (8 * b)) & 0xff;
+            digest *= 1099511628211ULL;
+        }
+    };
+    std::vector<double> makespans, waits;
+    for (const Dock &d : w.docks) waits.insert(waits.end(), d.waits.begin(), d.waits.end());
+    long stalled = 0, world = 0;
+    trips = 0;
+    for (int i = 0; i < cfg.islands; ++i) {
+        const IslandState &s = w.islands[i];
+        trips += s.trips;
+        mix(s.trips);
+        mix(w.makespan[i]);
+        mix(w.waitTotal[i]);
+        mix(s.stalled);
+        if (s.stalled) { stalled++; continue; }
+        makespans.push_back(static_cast<double>(w.makespan[i]));
+        world = std::max(world, w.makespan[i]);
+    }
+
+    std::cout << "Multi-island Summary (" << (cfg.lps ? "parallel" : "sequential") << ")" << std::endl;
+    std::cout << "Islands: " << cfg.islands << " (" << cfg.adults << " adults, " << cfg.children
+              << " children each), berths: " << cfg.berths << " at " << cfg.docks << " docks, seed: " << cfg.seed
+              << ", policy: " << policy_name(cfg.policy) << std::endl;
+    if (cfg.lps) {
+        std::cout << "Logical processes: " << cfg.lps << ", windows: " << stats.windows << ", busiest LP: "
+                  << stats.busiest << " events (" << std::fixed << std::setprecision(1)
+                  << 100.0 * static_cast<double>(stats.busiest) / static_cast<double>(std::max(1L, stats.events))
+                  << "%)" << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+    std::cout << "Events: " << stats.events << " (docks " << stats.mainlandEvents << "), trips: " << trips
+              << " (stalled islands: " << stalled << ")" << std::endl;
+    std::cout << "World makespan (s): " << world << std::endl;
+    print_summary_line(std::cout, "Island makespan (s)", summarize(makespans));
+    print_summary_line(std::cout, "Berth wait (s)", summarize(waits));
+    std::cout << "Result digest: " << std::hex << std::setw(16) << std::setfill('0') << digest
+              << std::dec << std::setfill(' ') << std::endl;
+    std::cout << "Wall time (s): " << wall << std::endl;
+    return stalled == cfg.islands ? 1 : 0;
+}
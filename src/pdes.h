@@ -0,0 +1,68 @@
+/**
+ * @file src/pdes.h
+ *
+ * @brief Multi-island virtual-time world, sequential or as a conservative PDES.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * `--islands N` simulates N islands, each with its own boat and population
+ * (a `Ferry`). The mainland has `docks` docks sharing the berths evenly, and
+ * the islands are split into as many contiguous ranges, each landing at
+ * its own dock. A boat that reaches the mainland waits for a free berth of
+ * its dock (first come, first served), holds it for one second while it
+ * unloads and turns around, then rows back. A dock couples its islands: one
+ * island's traffic delays the others' return trips.
+ *
+ * The world is split into K logical processes (LPs), each owning a range
+ * of islands (their ferries and trip-time streams) and the docks whose
+ * first island is in that range. A single mainland LP would handle half of
+ * all events and cap the speedup near 2x. LPs only talk by timestamped
+ * messages:
+ *
+ * - island -> dock: "boat i docks at t + trip time" (sent on departure);
+ * - dock -> island: "boat i leaves the mainland at grant + 1".
+ *
+ * With at least as many docks as LPs, nearly all of them stay on one LP.
+ *
+ * Trip times are at least one second and the turnaround is one second, so
+ * every message lands at least one second after it is sent. That lookahead
+ * drives a conservative time-window protocol: all LPs, each on its own
+ * thread, process their events with timestamps in [T, T + 1) in parallel,
+ * exchange messages at a barrier, and move T to the earliest pending event
+ * anywhere. No LP ever receives a message in its past.
+ *
+ * Every LP handles its events in (time, kind, island) order, which is also
+ * the order of the single event queue of the sequential engine (`lps = 0`),
+ * so both produce the same result. The printed digest makes that easy to
+ * check.
+ */
+
+#ifndef PDES_H
+#define PDES_H
+
+#include <cstdint>
+
+#include "policy.h"
+
+/**
+ * @struct PdesConfig
+ *
+ * @brief What to run in `--islands` mode.
+ */
+struct PdesConfig {
+    int islands = 0;
+    int adults = 0;   // per island
+    int children = 0; // per island
+    int berths = 1;   // at the mainland, over all docks
+    int docks = 1;    // mainland docks, each serving a contiguous range of islands
+    std::uint64_t seed = 0;
+    Policy policy = Policy::FIRST_FIT;
+    unsigned lps = 0; // logical processes (one thread each); 0 = sequential
+};
+
+int run_pdes(const PdesConfig &cfg, long &trips);
+
+#endif
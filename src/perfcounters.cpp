@@ -0,0 +1,120 @@
+/**
+ * @file src/perfcounters.cpp
+ *
+ * @brief Hardware and software performance counters via perf_event_open.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "perfcounters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Display name of a counter.
+ *
+ * @param c Counter.
+ *
+ * @return const char* Name.
+ */
+const char* perf_counter_name(PerfCounter c) {
+    switch (c) {
+    case PC_CYCLES: return "cycles";
+    case PC_INSTRUCTIONS: return "instructions";
+    case PC_CACHE_MISSES: return "cache misses";
+    case PC_BRANCH_MISSES: return "branch misses";
+    case PC_CONTEXT_SWITCHES: return "context switches";
+    default: return "?";
+    }
+}
+
+/**
+ * @brief Context switches (voluntary + involuntary) of the whole process so far.
+ *
+ * @return long Count from getrusage(RUSAGE_SELF).
+ */
+static long rusage_switches() {
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_nvcsw + ru.ru_nivcsw;
+}
+
+/**
+ * @brief Open every counter, disabled, for this thread and its future threads.
+ */
+PerfCounters::PerfCounters() {
+    static const std::uint32_t types[PC_COUNT] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE,
+    };
+    static const std::uint64_t configs[PC_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_CONTEXT_SWITCHES,
+    };
+    for (int c = 0; c < PC_COUNT; ++c) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = types[c];
+        attr.config = configs[c];
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        if (types[c] == PERF_TYPE_SOFTWARE) attr.exclude_kernel = 0; // switches happen in the kernel
+        fd[c] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd[c] < 0 && reason.empty())
+            reason = std::string(perf_counter_name(static_cast<PerfCounter>(c))) + ": " + std::strerror(errno);
+    }
+}
+
+/**
+ * @brief Close the counters.
+ */
+PerfCounters::~PerfCounters() {
+    for (int c = 0; c < PC_COUNT; ++c) if (fd[c] >= 0) close(fd[c]);
+}
+
+/**
+ * @brief Reset and enable every counter.
+ *
+ * @return void
+ */
+void PerfCounters::start() {
+    rusageSwitches = rusage_switches();
+    for (int c = 0; c < PC_COUNT; ++c) {
+        if (fd[c] < 0) continue;
+        ioctl(fd[c], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/**
+ * @brief Disable every counter and add the region's counts to the totals.
+ *
+ * @return void
+ *
+ * @details Counts are scaled by enabled/running time when the kernel had to
+ *          multiplex the PMU.
+ */
+void PerfCounters::stop() {
+    for (int c = 0; c < PC_COUNT; ++c) {
+        if (fd[c] < 0) continue;
+        ioctl(fd[c], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int c = 0; c < PC_COUNT; ++c) {
+        if (fd[c] < 0) continue;
+        std::uint64_t buf[3] = {}; // value, time enabled, time running
+        if (read(fd[c], buf, sizeof buf) != static_cast<ssize_t>(sizeof buf)) continue;
+        double scale = buf[2] ? double(buf[1]) / double(buf[2]) : 1.0;
+        value[c] += double(buf[0]) * scale;
+    }
+    if (fd[PC_CONTEXT_SWITCHES] < 0) value[PC_CONTEXT_SWITCHES] += rusage_switches() - rusageSwitches;
+}
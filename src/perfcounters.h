@@ -0,0 +1,61 @@
+/**
+ * @file src/perfcounters.h
+ *
+ * @brief Hardware and software performance counters via perf_event_open.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Counts cycles, instructions, cache misses, branch misses and context
+ * switches of the calling thread and every thread it creates afterwards
+ * (`inherit`), between `start()` and `stop()`. Counters that cannot be
+ * opened (no PMU in a VM, `perf_event_paranoid`, seccomp) are reported as
+ * unavailable. Context switches then fall back to getrusage, which also
+ * covers threads that have already been joined.
+ */
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum PerfCounter
+ *
+ * @brief Counters read around each benchmark region.
+ */
+enum PerfCounter { PC_CYCLES, PC_INSTRUCTIONS, PC_CACHE_MISSES, PC_BRANCH_MISSES, PC_CONTEXT_SWITCHES, PC_COUNT };
+
+/**
+ * @class PerfCounters
+ *
+ * @brief One set of counters, reused across regions; values accumulate.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    void start();
+    void stop();
+
+    bool available(PerfCounter c) const { return fd[c] >= 0 || (c == PC_CONTEXT_SWITCHES); }
+    double total(PerfCounter c) const { return value[c]; }
+    const std::string &why_unavailable() const { return reason; }
+
+private:
+    int fd[PC_COUNT];
+    double value[PC_COUNT] = {};
+    long rusageSwitches = 0; // context switches at start() when using the fallback
+    std::string reason;      // first open error, empty if all opened
+};
+
+const char* perf_counter_name(PerfCounter c);
+
+#endif
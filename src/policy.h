@@ -0,0 +1,174 @@
+/**
+ * @file src/policy.h
+ *
+ * @brief Crew selection policies shared by the threaded simulation and the model.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The selection functions are templates so that `find_person` (over
+ * `Person`) and the sequential `Ferry` (over `SimPerson`) run literally the
+ * same code, which keeps model and threads in step for every policy.
+ */
+
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "island.h"
+
+/**
+ * @enum Policy
+ *
+ * @brief How the controller picks among eligible people.
+ *
+ * - FIRST_FIT: first eligible person in creation order (the original rule).
+ * - LEAST_ROWED: eligible person with the fewest consecutive rows.
+ * - ROUND_ROBIN: first eligible person after the previously chosen one.
+ * - FIFO: first eligible person in the order they reached the shore, taken
+ *   from the waiting queues of `dock.h` instead of a scan.
+ * - PRIORITY: most urgent priority class first, then earliest deadline,
+ *   taken from the heaps of `triage.h`.
+ * - EDF: earliest deadline first, then priority class (`triage.h`).
+ */
+enum class Policy { FIRST_FIT, LEAST_ROWED, ROUND_ROBIN, FIFO, PRIORITY, EDF };
+
+/**
+ * @brief Command line name of a policy.
+ *
+ * @param p Policy.
+ *
+ * @return const char* Name accepted by `parse_policy`.
+ */
+inline const char* policy_name(Policy p) {
+    switch (p) {
+    case Policy::FIRST_FIT: return "first-fit";
+    case Policy::LEAST_ROWED: return "least-rowed";
+    case Policy::ROUND_ROBIN: return "round-robin";
+    case Policy::FIFO: return "fifo";
+    case Policy::PRIORITY: return "priority";
+    case Policy::EDF: return "edf";
+    }
+    return "?";
+}
+
+/**
+ * @brief Parse a policy name.
+ *
+ * @param name Name as printed by `policy_name`.
+ * @param out Parsed policy (filled on success).
+ *
+ * @return true if the name is known.
+ */
+inline bool parse_policy(const std::string &name, Policy &out) {
+    for (Policy p : {Policy::FIRST_FIT, Policy::LEAST_ROWED, Policy::ROUND_ROBIN, Policy::FIFO,
+                     Policy::PRIORITY, Policy::EDF}) {
+        if (name == policy_name(p)) { out = p; return true; }
+    }
+    return false;
+}
+
+template <typename P> P* as_ptr(P &p) { return &p; }
+template <typename P> P* as_ptr(std::unique_ptr<P> &p) { return p.get(); }
+
+/**
+ * @brief Pick a free person of the given age at the given location.
+ *
+ * @param people Container of people (objects or unique_ptrs).
+ * @param wantAdult true for adult, false for child.
+ * @param where Location to search.
+ * @param excludeNeedsBreak whether to exclude those needing a break.
+ * @param policy Selection policy.
+ * @param cursor Round-robin position, updated when a person is picked.
+ *
+ * @return Pointer to the chosen person or nullptr if none found.
+ *
+ * @details Every policy prefers people below the consecutive-row limit and
+ *          falls back to anyone free, like the original two-pass scan.
+ */
+template <typename People>
+auto select_person(People &people, bool wantAdult, Loc where, bool excludeNeedsBreak,
+                   Policy policy, std::size_t &cursor) -> decltype(as_ptr(people[0])) {
+    using Ptr = decltype(as_ptr(people[0]));
+    const std::size_t n = people.size();
+    auto eligible = [&](Ptr p) {
+        return p->isAdult == wantAdult && p->position == where &&
+               p->role == std::remove_pointer_t<Ptr>::NONE &&
+               !(excludeNeedsBreak && p->needsBreak);
+    };
+
+    if (policy == Policy::LEAST_ROWED) {
+        Ptr best = nullptr;
+        for (auto &e : people) {
+            Ptr p = as_ptr(e);
+            if (!eligible(p)) continue;
+            if (!best || p->consecutiveRows < best->consecutiveRows) best = p;
+        }
+        return best;
+    }
+
+    std::size_t start = (policy == Policy::ROUND_ROBIN && n) ? cursor % n : 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (std::size_t k = 0; k < n; ++k) {
+            std::size_t i = start + k;
+            if (i >= n) i -= n;
+            Ptr p = as_ptr(people[i]);
+            if (!eligible(p)) continue;
+            if (pass == 0 && p->consecutiveRows >= MAX_CONSECUTIVE) continue;
+            if (policy == Policy::ROUND_ROBIN) cursor = i + 1;
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Pick the second child of a two-child crew leaving the island.
+ *
+ * @param people Container of people (objects or unique_ptrs).
+ * @param first Child already chosen as driver.
+ * @param policy Selection policy.
+ * @param cursor Round-robin position, updated when a child is picked.
+ *
+ * @return Pointer to the chosen child or nullptr if none found.
+ *
+ * @details Any free island child other than `first` qualifies; the row
+ *          limit does not apply because the partner only rides along.
+ */
+template <typename People, typename Ptr>
+Ptr select_partner(People &people, Ptr first, Policy policy, std::size_t &cursor) {
+    const std::size_t n = people.size();
+    auto eligible = [&](Ptr p) {
+        return !p->isAdult && p->position == ISLAND &&
+               p->role == std::remove_pointer_t<Ptr>::NONE && p != first;
+    };
+
+    if (policy == Policy::LEAST_ROWED) {
+        Ptr best = nullptr;
+        for (auto &e : people) {
+            Ptr p = as_ptr(e);
+            if (!eligible(p)) continue;
+            if (!best || p->consecutiveRows < best->consecutiveRows) best = p;
+        }
+        return best;
+    }
+
+    std::size_t start = (policy == Policy::ROUND_ROBIN && n) ? cursor % n : 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t i = start + k;
+        if (i >= n) i -= n;
+        Ptr p = as_ptr(people[i]);
+        if (!eligible(p)) continue;
+        if (policy == Policy::ROUND_ROBIN) cursor = i + 1;
+        return p;
+    }
+    return nullptr;
+}
+
+#endif
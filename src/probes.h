@@ -0,0 +1,47 @@
+/**
+ * @file src/probes.h
+ *
+ * @brief USDT static probes at every point of a trip's lifecycle.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * With `<sys/sdt.h>` available (systemtap-sdt-dev on Debian/Ubuntu) each
+ * probe compiles to a single `nop` plus an ELF note, so the probes cost
+ * next to nothing until bpftrace or perf attaches to them. Without the
+ * header they compile to nothing at all.
+ *
+ * Provider `island`, probes and arguments (`adult` is 1 for adults, 0 for
+ * children; `role` is `Person::Role`; `dir` is the `Loc` the boat leaves):
+ *
+ * - assign(driver_id, driver_adult, passenger_id, passenger_adult, dir)
+ *   controller picked a crew (passenger_id 0 when rowing alone)
+ * - seat(id, adult, role, dir)       a crew member sat down
+ * - depart(driver_id, driver_adult, passenger_id, dir, trip_s)
+ * - arrive(driver_id, driver_adult, passenger_id, dir, trip_s)
+ * - reset(id, adult, role, position) a crew member was released after the trip
+ *
+ * Example: `bpftrace -e 'usdt:./bin/island:island:depart { @[arg3] = hist(arg4); }'`
+ */
+
+#ifndef PROBES_H
+#define PROBES_H
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>) && !defined(ISLAND_NO_PROBES)
+#include <sys/sdt.h>
+#define ISLAND_HAVE_PROBES 1
+#endif
+#endif
+
+#ifdef ISLAND_HAVE_PROBES
+#define ISLAND_PROBE4(name, a, b, c, d) DTRACE_PROBE4(island, name, a, b, c, d)
+#define ISLAND_PROBE5(name, a, b, c, d, e) DTRACE_PROBE5(island, name, a, b, c, d, e)
+#else
+#define ISLAND_PROBE4(name, a, b, c, d) do {} while (0)
+#define ISLAND_PROBE5(name, a, b, c, d, e) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file src/profiler.cpp
+ *
+ * @brief Sampling profiler that attributes samples to simulation phases.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "profiler.h"
+
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <sys/time.h>
+#include <vector>
+
+thread_local PhaseSlot* tlsPhase = nullptr;
+
+// all slots ever handed out; dead ones are reused
+static std::mutex registryMtx;
+static std::deque<PhaseSlot> slots;
+static std::vector<PhaseSlot*> freeSlots;
+
+// SIGPROF samples by phase (lock-free atomics, safe in the handler)
+static std::atomic<std::uint64_t> cpuCounts[PH_COUNT];
+
+/**
+ * @brief Display name of a phase.
+ *
+ * @param p Phase.
+ *
+ * @return const char* Name.
+ */
+const char* phase_name(Phase p) {
+    static const char* names[PH_COUNT] = {
+        "other", "selecting crew", "locking Boat::mtx", "holding Boat::mtx",
+        "spinning", "output", "travel (sleep)", "waiting on cv",
+    };
+    return p < PH_COUNT ? names[p] : "?";
+}
+
+/**
+ * @brief Give the calling thread a phase slot.
+ *
+ * @return void
+ */
+void phase_register() {
+    std::lock_guard<std::mutex> lk(registryMtx);
+    PhaseSlot* s;
+    if (!freeSlots.empty()) {
+        s = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slots.emplace_back();
+        s = &slots.back();
+    }
+    s->phase.store(PH_OTHER, std::memory_order_relaxed);
+    s->live.store(true, std::memory_order_release);
+    tlsPhase = s;
+}
+
+/**
+ * @brief Release the calling thread's slot.
+ *
+ * @return void
+ */
+void phase_unregister() {
+    if (!tlsPhase) return;
+    std::lock_guard<std::mutex> lk(registryMtx);
+    tlsPhase->live.store(false, std::memory_order_release);
+    freeSlots.push_back(tlsPhase);
+    tlsPhase = nullptr;
+}
+
+/**
+ * @brief SIGPROF handler: count the interrupted thread's phase.
+ *
+ * @param sig Unused.
+ *
+ * @return void
+ */
+static void on_sigprof(int) {
+    PhaseSlot* s = tlsPhase;
+    std::uint8_t p = s ? s->phase.load(std::memory_order_relaxed) : static_cast<std::uint8_t>(PH_OTHER);
+    cpuCounts[p < PH_COUNT ? p : static_cast<std::uint8_t>(PH_OTHER)].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start both samplers.
+ *
+ * @param cpuHz SIGPROF rate per CPU-second.
+ * @param wallHz Rate of the wall-clock sampler thread.
+ *
+ * @return void
+ */
+void Profiler::start(int cpuHz, int wallHz) {
+    this->cpuHz = cpuHz;
+    this->wallHz = wallHz;
+    for (auto &c : cpuCounts) c.store(0, std::memory_order_relaxed);
+
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof sa);
+    sa.sa_handler = on_sigprof;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGPROF, &sa, nullptr);
+
+    itimerval it;
+    it.it_interval.tv_sec = 0;
+    it.it_interval.tv_usec = 1000000 / cpuHz;
+    it.it_value = it.it_interval;
+    setitimer(ITIMER_PROF, &it, nullptr);
+
+    began = std::chrono::steady_clock::now();
+    sampler = std::thread(&Profiler::poll, this);
+}
+
+/**
+ * @brief Stop both samplers and collect the CPU samples.
+ *
+ * @return void
+ */
+void Profiler::stop() {
+    itimerval off;
+    std::memset(&off, 0, sizeof off);
+    setitimer(ITIMER_PROF, &off, nullptr);
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        stopping = true;
+    }
+    cv.notify_one();
+    sampler.join();
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+    for (int p = 0; p < PH_COUNT; ++p) cpuSamples[p] = cpuCounts[p].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Wall-clock sampler thread: count every live thread's phase.
+ *
+ * @return void
+ *
+ * @details The sampler itself is not registered, so it never counts itself.
+ */
+void Profiler::poll() {
+    auto period = std::chrono::microseconds(1000000 / wallHz);
+    auto next = std::chrono::steady_clock::now() + period;
+    std::unique_lock<std::mutex> lk(mtx);
+    while (!cv.wait_until(lk, next, [&]{ return stopping; })) {
+        next += period;
+        wallTicks++;
+        std::lock_guard<std::mutex> reg(registryMtx);
+        for (auto &s : slots) {
+            if (!s.live.load(std::memory_order_acquire)) continue;
+            wallSamples[s.phase.load(std::memory_order_relaxed)]++;
+        }
+    }
+}
+
+/**
+ * @brief Print the flat profile by phase.
+ *
+ * @param os Output stream.
+ *
+ * @return void
+ *
+ * @details CPU columns: share of SIGPROF samples and the CPU time they
+ *          stand for. Wall columns: share of thread-samples and the average
+ *          number of threads in that phase.
+ */
+void Profiler::print(std::ostream &os) const {
+    std::uint64_t cpuTotal = 0, wallTotal = 0;
+    for (int p = 0; p < PH_COUNT; ++p) {
+        cpuTotal += cpuSamples[p];
+        wallTotal += wallSamples[p];
+    }
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize prec = os.precision();
+    os << "Phase Profile (" << std::fixed << std::setprecision(2) << seconds << " s; CPU "
+       << cpuTotal << " samples at " << cpuHz << " Hz, wall " << wallTicks << " ticks at " << wallHz << " Hz)" << std::endl;
+    os << std::left << std::setw(20) << "phase" << std::right
+       << std::setw(10) << "cpu %" << std::setw(12) << "cpu ms" << std::setw(10) << "wall %"
+       << std::setw(12) << "avg threads" << std::endl;
+    for (int p = 0; p < PH_COUNT; ++p) {
+        if (!cpuSamples[p] && !wallSamples[p]) continue;
+        os << std::left << std::setw(20) << phase_name(static_cast<Phase>(p)) << std::right << std::setprecision(1)
+           << std::setw(10) << (cpuTotal ? 100.0 * cpuSamples[p] / cpuTotal : 0)
+           << std::setw(12) << 1000.0 * cpuSamples[p] / cpuHz
+           << std::setw(10) << (wallTotal ? 100.0 * wallSamples[p] / wallTotal : 0)
+           << std::setprecision(2) << std::setw(12) << (wallTicks ? double(wallSamples[p]) / wallTicks : 0)
+           << std::endl;
+    }
+    os.flags(flags);
+    os.precision(prec);
+}
@@ -0,0 +1,160 @@
+/**
+ * @file src/profiler.h
+ *
+ * @brief Sampling profiler that attributes samples to simulation phases.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Every engine thread publishes its current phase in a slot of its own (one
+ * relaxed byte store per phase change). Two samplers read those slots:
+ *
+ * - CPU: `ITIMER_PROF` delivers SIGPROF to whichever thread is burning CPU;
+ *   the handler counts the phase of that thread. This shows where CPU time
+ *   goes.
+ * - Wall: a sampler thread walks all registered slots at a fixed rate and
+ *   counts every live thread's phase. This shows where threads spend their
+ *   time, including blocked and sleeping time.
+ *
+ * Neither needs an external tool, and both cost one store per phase change
+ * in the engine, so they scale to very large populations.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+/**
+ * @enum Phase
+ *
+ * @brief What a thread is doing.
+ *
+ * - PH_OTHER: not inside the simulation core.
+ * - PH_SELECTING: controller choosing and waking the next crew.
+ * - PH_LOCKING: acquiring `Boat::mtx`.
+ * - PH_HOLDING: holding `Boat::mtx` (bookkeeping).
+ * - PH_SPINNING: driver yielding until the passenger is seated.
+ * - PH_OUTPUT: formatting the narration.
+ * - PH_TRAVEL: sleeping for the trip time.
+ * - PH_WAITING: blocked on a condition variable.
+ */
+enum Phase : std::uint8_t {
+    PH_OTHER, PH_SELECTING, PH_LOCKING, PH_HOLDING, PH_SPINNING, PH_OUTPUT, PH_TRAVEL, PH_WAITING,
+    PH_COUNT
+};
+
+/**
+ * @struct PhaseSlot
+ *
+ * @brief Published phase of one thread.
+ */
+struct PhaseSlot {
+    std::atomic<std::uint8_t> phase{PH_OTHER};
+    std::atomic<bool> live{false};
+};
+
+// calling thread's slot, null when the thread is not registered
+extern thread_local PhaseSlot* tlsPhase;
+
+inline Phase phase_get() {
+    return tlsPhase ? static_cast<Phase>(tlsPhase->phase.load(std::memory_order_relaxed)) : PH_OTHER;
+}
+
+inline void phase_set(Phase p) {
+    if (tlsPhase) tlsPhase->phase.store(p, std::memory_order_relaxed);
+}
+
+void phase_register();
+void phase_unregister();
+
+/**
+ * @class PhaseScope
+ *
+ * @brief Sets a phase until `end()` or destruction, then restores the old one.
+ *        The `false` specialization compiles to nothing.
+ */
+template <bool On>
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase) {}
+    void end() {}
+};
+
+template <>
+class PhaseScope<true> {
+public:
+    explicit PhaseScope(Phase p) : prev(phase_get()) { phase_set(p); }
+    ~PhaseScope() { end(); }
+    void end() {
+        if (active) phase_set(prev);
+        active = false;
+    }
+
+    PhaseScope(const PhaseScope &) = delete;
+    PhaseScope &operator=(const PhaseScope &) = delete;
+
+private:
+    Phase prev;
+    bool active = true;
+};
+
+/**
+ * @class PhaseThread
+ *
+ * @brief Registers the calling thread for its lifetime (no-op when off).
+ */
+template <bool On>
+class PhaseThread {
+public:
+    PhaseThread() {}
+};
+
+template <>
+class PhaseThread<true> {
+public:
+    PhaseThread() { phase_register(); }
+    ~PhaseThread() { phase_unregister(); }
+
+    PhaseThread(const PhaseThread &) = delete;
+    PhaseThread &operator=(const PhaseThread &) = delete;
+};
+
+/**
+ * @class Profiler
+ *
+ * @brief Runs both samplers from `start()` to `stop()`.
+ */
+class Profiler {
+public:
+    void start(int cpuHz = 997, int wallHz = 100);
+    void stop();
+    void print(std::ostream &os) const;
+
+private:
+    void poll();
+
+    int cpuHz = 0, wallHz = 0;
+    std::uint64_t wallSamples[PH_COUNT] = {};
+    std::uint64_t cpuSamples[PH_COUNT] = {};
+    std::uint64_t wallTicks = 0;
+    double seconds = 0;
+
+    std::mutex mtx; // guards `stopping`
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread sampler;
+    std::chrono::steady_clock::time_point began;
+};
+
+const char* phase_name(Phase p);
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file src/reactor.cpp
+ *
+ * @brief A fleet of independent boats run in real time by epoll reactors.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "reactor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "model.h"
+#include "parallel.h"
+#include "stats.h"
+#include "workdeque.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @struct FleetBoat
+ *
+ * @brief One boat of the fleet and the trip it has in flight.
+ */
+struct FleetBoat {
+    FleetBoat(int adults, int children, Policy policy, std::mt19937::result_type seed)
+        : ferry(adults, children, policy), rng(seed) {}
+
+    Ferry ferry;
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> dist{1,4};
+    Trip trip;
+    Clock::time_point departed; // of the trip in flight
+    Clock::time_point due;      // its arrival deadline
+    double makespan = 0;        // seconds from the fleet start to the last arrival
+};
+
+/**
+ * @struct Worker
+ *
+ * @brief One reactor thread: its ready deque, its deadlines and what it measured.
+ *
+ * `ready` is shared with thieves; everything else is private to the worker.
+ */
+struct Worker {
+    using Entry = std::pair<Clock::time_point, std::uint32_t>;
+
+    WorkDeque<std::uint32_t> ready;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> timers;
+    std::vector<double> latenessMs; // arrival handled minus deadline, per trip
+    long trips = 0;
+    long wakeups = 0;
+    long steals = 0;
+    bool failed = false;
+};
+
+/**
+ * @struct Fleet
+ *
+ * @brief State shared by all workers of one `run_fleet`.
+ */
+struct Fleet {
+    std::vector<FleetBoat> boats;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<long> remaining{0}; // boats still ferrying
+    Clock::time_point start;
+    std::chrono::microseconds unit{0};
+};
+
+/**
+ * @brief Plan a boat's next trip and set its arrival deadline.
+ *
+ * @param b Boat.
+ * @param departed Departure time (the previous deadline).
+ * @param unit Real duration of one unit of trip time.
+ *
+ * @return bool false when the boat has nothing left to ferry.
+ */
+static bool launch(FleetBoat &b, Clock::time_point departed, std::chrono::microseconds unit) {
+    if (!b.ferry.plan(b.trip)) return false;
+    b.departed = departed;
+    b.due = departed + unit * b.dist(b.rng);
+    return true;
+}
+
+/**
+ * @brief Arm a timerfd for an absolute steady-clock deadline.
+ *
+ * @param fd Timer.
+ * @param due Deadline.
+ *
+ * @return bool false if the kernel rejected it.
+ *
+ * @details `steady_clock` is CLOCK_MONOTONIC on Linux, which is the clock
+ *          the timer was created on.
+ */
+static bool arm(int fd, Clock::time_point due) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(due.time_since_epoch()).count();
+    itimerspec its{};
+    its.it_value.tv_sec = ns / 1000000000;
+    its.it_value.tv_nsec = ns % 1000000000;
+    if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0) its.it_value.tv_nsec = 1; // 0 would disarm
+    return timerfd_settime(fd, TFD_TIMER_ABSTIME, &its, nullptr) == 0;
+}
+
+/**
+ * @brief Land boat `i`'s trip and launch its next one (the arrival task).
+ *
+ * @param f Fleet.
+ * @param w Worker running the task; the next deadline goes to its timers.
+ * @param i Boat.
+ *
+ * @return void
+ */
+static void arrive(Fleet &f, Worker &w, std::uint32_t i) {
+    FleetBoat &b = f.boats[i];
+    w.latenessMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - b.due).count());
+    b.ferry.finish(b.trip, std::chrono::duration<double>(b.departed - f.start).count(),
+                   std::chrono::duration<double>(b.due - f.start).count());
+    b.makespan = std::chrono::duration<double>(b.due - f.start).count();
+    w.trips++;
+    if (launch(b, b.due, f.unit)) w.timers.push({b.due, i});
+    else f.remaining.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief Try to take one ready task from another worker.
+ *
+ * @param f Fleet.
+ * @param self Index of the thief.
+ * @param out Output: boat whose arrival is due.
+ *
+ * @return bool true if something was stolen.
+ */
+static bool steal(Fleet &f, std::size_t self, std::uint32_t &out) {
+    std::size_t n = f.workers.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        if (f.workers[(self + k) % n]->ready.steal(out)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Mark a worker as failed and hand its boats to the other workers.
+ *
+ * @param w Worker whose epoll or timerfd failed.
+ *
+ * @return void
+ *
+ * @details Every pending deadline moves to the ready deque, where the
+ *          other workers steal it, so `Fleet::remaining` still reaches 0
+ *          and they do not poll forever for boats nobody runs.
+ */
+static void give_up(Worker &w) {
+    w.failed = true;
+    while (!w.timers.empty()) {
+        w.ready.push(w.timers.top().second);
+        w.timers.pop();
+    }
+}
+
+/**
+ * @brief Worker loop: run due arrivals, steal when idle, sleep until the next deadline.
+ *
+ * @param f Fleet.
+ * @param self Index of this worker.
+ *
+ * @return void
+ *
+ * @details Due deadlines move from the private heap to the ready deque,
+ *          where idle workers can steal them, so a burst of arrivals on one
+ *          worker is spread over all of them. With more than one worker an
+ *          idle one also wakes every millisecond to look for work to steal.
+ */
+static void run_worker(Fleet &f, std::size_t self) {
+    Worker &w = *f.workers[self];
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    if (ep < 0 || tfd < 0 || epoll_ctl(ep, EPOLL_CTL_ADD, tfd, &ev) != 0) {
+        give_up(w);
+        if (ep >= 0) close(ep);
+        if (tfd >= 0) close(tfd);
+        return;
+    }
+
+    int idleMs = f.workers.size() > 1 ? 1 : -1;
+    Clock::time_point armed{};
+    while (true) {
+        Clock::time_point now = Clock::now();
+        while (!w.timers.empty() && w.timers.top().first <= now) {
+            w.ready.push(w.timers.top().second);
+            w.timers.pop();
+        }
+
+        std::uint32_t i;
+        if (w.ready.pop(i)) { arrive(f, w, i); continue; }
+        if (steal(f, self, i)) { w.steals++; arrive(f, w, i); continue; }
+        if (f.remaining.load(std::memory_order_acquire) == 0) break;
+
+        if (!w.timers.empty() && armed != w.timers.top().first) {
+            if (!arm(tfd, w.timers.top().first)) { give_up(w); break; }
+            armed = w.timers.top().first;
+        }
+        epoll_event got;
+        int n = epoll_wait(ep, &got, 1, idleMs);
+        if (n < 0 && errno != EINTR) { give_up(w); break; }
+        if (n <= 0) continue;
+        std::uint64_t expirations;
+        if (read(tfd, &expirations, sizeof expirations) < 0 && errno != EAGAIN) { give_up(w); break; }
+        w.wakeups++;
+    }
+
+    close(tfd);
+    close(ep);
+}
+
+/**
+ * @brief Run a fleet of boats in real time and print its summary.
+ *
+ * @param cfg Fleet size, population per boat, seed, policy, trip unit and reactor count.
+ * @param trips Output: trips made by the whole fleet.
+ *
+ * @return int 0 on success, 1 if a reactor failed or every boat stalled.
+ *
+ * @details A boat's makespan is its final arrival deadline, in real
+ *          seconds from the common start; how late each arrival was
+ *          handled (timer wakeup plus queueing) is reported separately.
+ */
+int run_fleet(const FleetConfig &cfg, long &trips) {
+    Fleet f;
+    f.boats.reserve(cfg.boats);
+    for (int i = 0; i < cfg.boats; ++i)
+        f.boats.emplace_back(cfg.adults, cfg.children, cfg.policy, replica_seed(cfg.seed, i));
+
+    unsigned reactors = std::min<unsigned>(worker_count(cfg.reactors), cfg.boats);
+    f.unit = cfg.tripUnit;
+    for (unsigned k = 0; k < reactors; ++k) f.workers.push_back(std::make_unique<Worker>());
+    f.start = Clock::now();
+    for (std::size_t i = 0; i < f.boats.size(); ++i) {
+        // boats start spread evenly; stealing rebalances them from there
+        if (!launch(f.boats[i], f.start, f.unit)) continue;
+        f.workers[i * reactors / f.boats.size()]->timers.push({f.boats[i].due, static_cast<std::uint32_t>(i)});
+        f.remaining++;
+    }
+    parallel_for(reactors, reactors, [&](long k, unsigned) { run_worker(f, k); }, 1);
+    double wall = std::chrono::duration<double>(Clock::now() - f.start).count();
+
+    std::vector<double> lateness, makespans;
+    long wakeups = 0, steals = 0, stalled = 0;
+    bool failed = false;
+    trips = 0;
+    for (auto &w : f.workers) {
+        lateness.insert(lateness.end(), w->latenessMs.begin(), w->latenessMs.end());
+        trips += w->trips;
+        wakeups += w->wakeups;
+        steals += w->steals;
+        failed = failed || w->failed;
+    }
+    for (auto &b : f.boats) {
+        if (b.ferry.stalled()) { stalled++; continue; }
+        makespans.push_back(b.makespan);
+    }
+
+    std::cout << "Fleet Summary" << std::endl;
+    std::cout << "Boats: " << cfg.boats << " (" << cfg.adults << " adults, " << cfg.children
+              << " children each), seed: " << cfg.seed << ", policy: " << policy_name(cfg.policy) << std::endl;
+    std::cout << "Reactor threads: " << reactors << ", timer wakeups: " << wakeups << ", steals: " << steals
+              << ", trips: " << trips << " (stalled boats: " << stalled << ")" << std::endl;
+    print_summary_line(std::cout, "Makespan (s)", summarize(makespans));
+    print_summary_line(std::cout, "Arrival lateness (ms)", summarize(lateness));
+    std::cout << "Wall time (s): " << wall << std::endl;
+    if (failed) std::cerr << "a reactor could not set up or wait on its timerfd" << std::endl;
+    if (f.remaining.load() > 0) std::cerr << f.remaining.load() << " boats were left unfinished" << std::endl;
+    return failed || f.remaining.load() > 0 || stalled == cfg.boats ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file src/reactor.h
+ *
+ * @brief A fleet of independent boats run in real time by epoll reactors.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The threaded engine pins a thread per person and a driver thread in
+ * `sleep_for` per trip. Fleet mode instead runs every boat as a `Ferry`
+ * state machine: each trip in flight is an entry (arrival deadline, boat)
+ * in a min-heap, and one `timerfd` registered with epoll is armed for the
+ * earliest deadline. When it fires the reactor finishes every trip that is
+ * due, plans each boat's next crossing and pushes its new deadline. Trips
+ * still take real seconds (`tripUnit` per unit of trip time), but a fleet of
+ * a thousand boats runs on a handful of reactor threads.
+ *
+ * With several reactors, dispatch is spread by work stealing: every reactor
+ * is a worker with its own deadline heap and a Chase-Lev deque
+ * (`workdeque.h`). Due arrivals move from the heap to the deque, and idle
+ * workers steal them, so the controller logic of each boat (`Ferry::plan`)
+ * runs on whichever core is free. The thief then owns the boat's next
+ * deadline.
+ *
+ * Deadlines are chained from the previous deadline rather than from the
+ * moment the reactor woke, so wakeup lateness never accumulates into the
+ * makespan. Boat `i` draws its trip times from `replica_seed(seed, i)`, so
+ * its trip sequence is the same as replica `i` of `--replicas`.
+ */
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "policy.h"
+
+/**
+ * @struct FleetConfig
+ *
+ * @brief What to run in `--fleet` mode.
+ */
+struct FleetConfig {
+    int boats = 0;
+    int adults = 0;   // per boat
+    int children = 0; // per boat
+    std::uint64_t seed = 0;
+    Policy policy = Policy::FIRST_FIT;
+    std::chrono::microseconds tripUnit{1000000};
+    unsigned reactors = 1; // worker threads; boats start split evenly and are rebalanced by stealing
+};
+
+int run_fleet(const FleetConfig &cfg, long &trips);
+
+#endif
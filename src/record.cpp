@@ -0,0 +1,190 @@
+/**
+ * @file src/record.cpp
+ *
+ * @brief Recording of a threaded run and its replay in virtual time.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "record.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "engine.h"
+#include "model.h"
+
+/**
+ * @brief Write the record as text: a header of `key value` lines, then one line per event.
+ *
+ * @param path Output file.
+ *
+ * @return bool false if the file could not be written.
+ */
+bool RunRecord::write(const std::string &path) const {
+    std::ofstream f(path);
+    if (!f) return false;
+    f << "# island run record" << "\n"
+      << "adults " << adults << "\n"
+      << "children " << children << "\n"
+      << "policy " << policy_name(policy) << "\n"
+      << "seed " << seed << "\n"
+      << "priority-classes " << triage.classes << "\n"
+      << "deadline " << triage.deadline << "\n"
+      << "events " << events.size() << "\n";
+    for (const RecordEvent &e : events) {
+        f << static_cast<char>(e.kind) << " " << e.a;
+        if (e.kind == RecordEvent::TRAVEL) f << " " << e.b;
+        f << "\n";
+    }
+    return static_cast<bool>(f.flush());
+}
+
+/**
+ * @brief Read a record written by `write`.
+ *
+ * @param path Input file.
+ * @param error Output: what is wrong with the file, on failure.
+ *
+ * @return bool true on success.
+ */
+bool RunRecord::read(const std::string &path, std::string &error) {
+    std::ifstream f(path);
+    if (!f) { error = "cannot open " + path; return false; }
+    std::string line, key;
+    long count = -1;
+    int lineNo = 0;
+    while (count < 0 && std::getline(f, line)) {
+        lineNo++;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream in(line);
+        in >> key;
+        bool ok = true;
+        if (key == "adults") ok = static_cast<bool>(in >> adults);
+        else if (key == "children") ok = static_cast<bool>(in >> children);
+        else if (key == "policy") { std::string p; ok = (in >> p) && parse_policy(p, policy); }
+        else if (key == "seed") ok = static_cast<bool>(in >> seed);
+        else if (key == "priority-classes") ok = static_cast<bool>(in >> triage.classes);
+        else if (key == "deadline") ok = static_cast<bool>(in >> triage.deadline);
+        else if (key == "events") ok = (in >> count) && count >= 0;
+        else ok = false;
+        if (!ok) { error = path + ":" + std::to_string(lineNo) + ": bad header line"; return false; }
+    }
+    if (count < 0 || adults <= 0 || children < 2 || triage.classes < 1) {
+        error = path + ": incomplete header";
+        return false;
+    }
+    triage.seed = seed;
+    events.clear();
+    events.reserve(static_cast<std::size_t>(count));
+    while (static_cast<long>(events.size()) < count && std::getline(f, line)) {
+        lineNo++;
+        std::istringstream in(line);
+        char kind = 0;
+        RecordEvent e;
+        bool ok = static_cast<bool>(in >> kind >> e.a);
+        if (kind == RecordEvent::TRAVEL) ok = ok && (in >> e.b);
+        else if (kind != RecordEvent::DRIVER && kind != RecordEvent::PASSENGER) ok = false;
+        if (!ok) { error = path + ":" + std::to_string(lineNo) + ": bad event"; return false; }
+        e.kind = static_cast<RecordEvent::Kind>(kind);
+        events.push_back(e);
+    }
+    if (static_cast<long>(events.size()) != count) {
+        error = path + ": truncated after " + std::to_string(events.size()) + " of " + std::to_string(count) + " events";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Replay a record in virtual time and print the run's output.
+ *
+ * @param rec Record.
+ * @param out Where the narration and summary go.
+ *
+ * @return int 0 on success, 1 if the record contradicts itself.
+ *
+ * @details Seats and departures are printed in recorded order, exactly as
+ *          `Person::run` prints them; each departure moves its crew in a
+ *          `Ferry`, whose counters then feed `print_summary`. A departure
+ *          without a driver, a crew member not on the boat's shore or a
+ *          boat leaving from the wrong shore stops the replay.
+ */
+int run_replay(const RunRecord &rec, std::ostream &out) {
+    auto t0 = std::chrono::steady_clock::now();
+    Ferry ferry(rec.adults, rec.children, rec.policy, rec.triage);
+    auto person = [&](int code) -> SimPerson* {
+        long i = code > 0 ? code - 1 : rec.adults - code - 1;
+        bool ok = code != 0 && (code > 0 ? code <= rec.adults : -code <= rec.children);
+        return ok ? &ferry.people[static_cast<std::size_t>(i)] : nullptr;
+    };
+    auto name = [](const SimPerson* p) { return std::string(p->isAdult ? "Adult " : "Child ") + std::to_string(p->id); };
+
+    SimPerson* driver = nullptr;
+    SimPerson* passenger = nullptr;
+    double clock = 0;
+    for (std::size_t i = 0; i < rec.events.size(); ++i) {
+        const RecordEvent &e = rec.events[i];
+        std::string bad;
+        if (e.kind != RecordEvent::TRAVEL) {
+            SimPerson* p = person(e.a);
+            SimPerson* &seat = e.kind == RecordEvent::DRIVER ? driver : passenger;
+            if (!p) bad = "unknown person " + std::to_string(e.a);
+            else if (seat || p == driver || p == passenger) bad = name(p) + " took a seat that was not free";
+            else if (p->position != ferry.location) bad = name(p) + " boarded on the wrong shore";
+            if (bad.empty()) {
+                seat = p;
+                out << name(p) << (e.kind == RecordEvent::DRIVER ? " got into the driver's seat of the boat."
+                                                                 : " got into the passenger seat of the boat.") << std::endl;
+                continue;
+            }
+        } else if (!driver) {
+            bad = "departure without a driver";
+        } else if (e.a != ferry.location || e.b < 0) {
+            bad = "departure from the wrong shore";
+        } else {
+            Trip trip;
+            trip.driver = driver;
+            trip.passenger = passenger;
+            trip.from = ferry.location;
+            trip.to = trip.from == ISLAND ? MAINLAND : ISLAND;
+            out << "Boat is traveling from " << (trip.from == ISLAND ? "island" : "mainland")
+                << " to " << (trip.to == ISLAND ? "island" : "mainland") << std::endl;
+            clock += e.b;
+            ferry.finish(trip, clock - e.b, clock);
+            driver = passenger = nullptr;
+            continue;
+        }
+        std::cerr << "replay: event " << i + 1 << ": " << bad << std::endl;
+        return 1;
+    }
+    if (driver || passenger) {
+        std::cerr << "replay: the record ends with a crew that never left" << std::endl;
+        return 1;
+    }
+
+    Boat boat;
+    boat.out = &out;
+    boat.tripsToMain = ferry.tripsToMain;
+    boat.tripsToIsland = ferry.tripsToIsland;
+    boat.twokidBoats = ferry.twokidBoats;
+    boat.kidAdultBoats = ferry.kidAdultBoats;
+    boat.soloBoats = ferry.soloBoats;
+    boat.adultDrivers = ferry.adultDrivers;
+    boat.childDrivers = ferry.childDrivers;
+    print_summary(boat);
+    if (rec.triage.classes > 1 || rec.triage.deadline > 0) print_triage(out, ferry.people, rec.triage);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cerr << "Replayed " << ferry.tripsToMain + ferry.tripsToIsland << " trips (virtual makespan " << clock
+              << " s) in " << ms << " ms";
+    if (ferry.adultsOnIsland > 0 || ferry.childrenOnIsland > 0) {
+        std::cerr << "; " << ferry.adultsOnIsland << " adults and " << ferry.childrenOnIsland
+                  << " children were left on the island";
+    }
+    std::cerr << std::endl;
+    return 0;
+}
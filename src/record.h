@@ -0,0 +1,77 @@
+/**
+ * @file src/record.h
+ *
+ * @brief Recording of a threaded run and its replay in virtual time.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * A threaded run depends on more than its arguments. The trip times come
+ * from a seeded RNG, but the order in which the crew of a trip sits down is
+ * up to the thread scheduler. With stragglers and boarding timeouts, even
+ * who makes up a crew is up to it. The boat completes one trip at a time, so
+ * the controller observes completions in trip order.
+ *
+ * `RunRecord` captures all of it, as the driver and passenger see it under
+ * `Boat::mtx`:
+ *
+ * - the configuration and the seed (which also fixes the priority classes
+ *   and deadlines);
+ * - every seat taken, in order;
+ * - every departure with its trip time.
+ *
+ * `run_replay` feeds the record to the sequential model with no threads and
+ * no sleeps. It prints the same narration and `print_summary` output as the
+ * recorded run, and checks every trip against the shore state on the way.
+ */
+
+#ifndef RECORD_H
+#define RECORD_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "island.h"
+#include "policy.h"
+#include "triage.h"
+
+/**
+ * @struct RecordEvent
+ *
+ * @brief One recorded step: a seat taken or a departure.
+ *
+ * People are coded like the flight recorder: +id for an adult, -id for a
+ * child.
+ */
+struct RecordEvent {
+    enum Kind : char { DRIVER = 'D', PASSENGER = 'P', TRAVEL = 'T' } kind = TRAVEL;
+    int a = 0; // seat: person; travel: shore the boat leaves
+    int b = 0; // travel: trip time in seconds
+};
+
+/**
+ * @struct RunRecord
+ *
+ * @brief Everything needed to replay a threaded run.
+ */
+struct RunRecord {
+    int adults = 0, children = 0;
+    Policy policy = Policy::FIRST_FIT;
+    std::uint64_t seed = 0;
+    Triage triage;
+    std::vector<RecordEvent> events; // appended under Boat::mtx
+
+    void seat(bool driver, int code) { events.push_back({driver ? RecordEvent::DRIVER : RecordEvent::PASSENGER, code, 0}); }
+    void travel(Loc from, int t) { events.push_back({RecordEvent::TRAVEL, from, t}); }
+
+    bool write(const std::string &path) const;
+    bool read(const std::string &path, std::string &error);
+};
+
+int run_replay(const RunRecord &rec, std::ostream &out);
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * @file src/replicas.cpp
+ *
+ * @brief Parallel Monte Carlo replicas of the model for makespan distributions.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "replicas.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "model.h"
+#include "parallel.h"
+#include "stats.h"
+
+/**
+ * @brief Mean of one replica's per-person waits.
+ *
+ * @param r Replica result.
+ *
+ * @return double Mean wait in seconds.
+ */
+static double mean_wait(const ReplicaResult &r) {
+    if (r.waits.empty()) return 0;
+    double sum = 0;
+    for (long w : r.waits) sum += w;
+    return sum / r.waits.size();
+}
+
+/**
+ * @brief Share of one replica's people who missed their deadline.
+ *
+ * @param r Replica result.
+ *
+ * @return double Miss rate in percent.
+ */
+static double miss_rate(const ReplicaResult &r) {
+    return r.waits.empty() ? 0 : 100.0 * r.deadlineMisses / r.waits.size();
+}
+
+/**
+ * @struct Batch
+ *
+ * @brief Results of replicas [first, first + count).
+ *
+ * Each replica writes only its own slot, so the outcome does not depend on
+ * how many threads ran the batch or in which order.
+ */
+struct Batch {
+    std::vector<double> makespans;
+    std::vector<double> meanWaits;
+    std::vector<double> missRates;
+    std::vector<char> stalled;
+    std::vector<IntHistogram> waitHist; // one per worker, merged afterwards
+};
+
+/**
+ * @brief Run a batch of replicas across worker threads.
+ *
+ * @param cfg Replica configuration.
+ * @param first Index of the first replica in the batch.
+ * @param count Number of replicas in the batch.
+ *
+ * @return Batch Per-replica results.
+ */
+static Batch run_batch(const ReplicaConfig &cfg, long first, long count) {
+    Batch b;
+    b.makespans.resize(count);
+    b.meanWaits.resize(count);
+    b.missRates.resize(count);
+    b.stalled.resize(count);
+
+    unsigned workers = worker_count(cfg.threads);
+    b.waitHist.resize(workers);
+    parallel_for(count, workers, [&](long i, unsigned w) {
+        ReplicaResult r = simulate_replica(cfg.adults, cfg.children,
+                                           replica_seed(cfg.seed, first + i), cfg.policy, cfg.triage);
+        b.makespans[i] = static_cast<double>(r.makespan);
+        b.meanWaits[i] = mean_wait(r);
+        b.missRates[i] = miss_rate(r);
+        b.stalled[i] = r.stalled;
+        if (!r.stalled) for (long wt : r.waits) b.waitHist[w].add(wt);
+    });
+    return b;
+}
+
+/**
+ * @brief Run `--replicas` mode and print the distribution report.
+ *
+ * @param cfg Replica configuration.
+ *
+ * @return int Process exit code.
+ *
+ * @details Replica `i` always uses the stream `replica_seed(seed, i)`, so a
+ *          report is reproducible for a given seed no matter how many cores
+ *          ran it. Stalled replicas are counted but left out of the
+ *          makespan and wait statistics.
+ */
+int run_replicas(const ReplicaConfig &cfg) {
+    std::vector<double> makespans, meanWaits, missRates;
+    IntHistogram waitHist;
+    long run = 0, stalled = 0;
+
+    long batch = cfg.replicas;
+    while (true) {
+        long count = std::min(batch, cfg.maxReplicas - run);
+        if (count <= 0) break;
+        Batch b = run_batch(cfg, run, count);
+        for (long i = 0; i < count; ++i) {
+            if (b.stalled[i]) { stalled++; continue; }
+            makespans.push_back(b.makespans[i]);
+            meanWaits.push_back(b.meanWaits[i]);
+            missRates.push_back(b.missRates[i]);
+        }
+        for (auto &h : b.waitHist) waitHist.merge(h);
+        run += count;
+
+        if (cfg.ciWidth <= 0) break;
+        Summary s = summarize(makespans);
+        if (s.n > 1 && 2 * s.ciHalfWidth <= cfg.ciWidth) break;
+    }
+
+    Summary ms = summarize(makespans);
+    Summary ws = summarize(meanWaits);
+    ws.p50 = waitHist.percentile(0.50);
+    ws.p90 = waitHist.percentile(0.90);
+    ws.p99 = waitHist.percentile(0.99);
+    ws.min = waitHist.percentile(0.0);
+    ws.max = waitHist.percentile(1.0);
+
+    std::cout << "Replica Summary" << std::endl;
+    std::cout << "Adults: " << cfg.adults << ", children: " << cfg.children
+              << ", seed: " << cfg.seed << ", policy: " << policy_name(cfg.policy) << std::endl;
+    std::cout << "Replicas run: " << run << " (stalled: " << stalled << ")" << std::endl;
+    print_summary_line(std::cout, "Makespan (s)", ms);
+    print_summary_line(std::cout, "Wait time (s)", ws);
+    if (cfg.triage.deadline > 0) print_summary_line(std::cout, "Deadline misses (%)", summarize(missRates));
+    if (cfg.ciWidth > 0 && 2 * ms.ciHalfWidth > cfg.ciWidth) {
+        std::cout << "Target CI width " << cfg.ciWidth << " s not reached after "
+                  << run << " replicas" << std::endl;
+    }
+    return stalled == run ? 1 : 0;
+}
+
+/**
+ * @brief Print one paired difference and how much CRN saved over independent runs.
+ *
+ * @param label Measured quantity.
+ * @param base Baseline samples.
+ * @param alt Alternative samples, paired with `base` by index.
+ *
+ * @return double Full width of the 95% CI of the mean difference.
+ *
+ * @details With independent runs the variance of a difference is
+ *          Var(base) + Var(alt); with common random numbers it is
+ *          Var(alt - base). Their ratio is how many times more replicas
+ *          independent runs would need for the same CI width.
+ */
+static double print_difference(const char *label, const std::vector<double> &base,
+                               const std::vector<double> &alt) {
+    std::vector<double> diff(base.size());
+    for (std::size_t i = 0; i < base.size(); ++i) diff[i] = alt[i] - base[i];
+    Summary d = summarize(diff);
+    Summary sb = summarize(base);
+    Summary sa = summarize(alt);
+
+    std::ios::fmtflags flags = std::cout.flags();
+    std::cout << std::fixed << std::setprecision(3)
+              << "  " << label << " difference: " << d.mean << " +/- " << d.ciHalfWidth << " (95% CI)";
+    double independent = sb.stddev * sb.stddev + sa.stddev * sa.stddev;
+    double paired = d.stddev * d.stddev;
+    if (paired > 0) {
+        std::cout << ", CRN needs " << std::setprecision(1) << independent / paired
+                  << "x fewer replicas than independent runs";
+    } else {
+        std::cout << ", identical on every replica";
+    }
+    std::cout << std::endl;
+    std::cout.flags(flags);
+    return 2 * d.ciHalfWidth;
+}
+
+/**
+ * @brief Compare policies on common random numbers and print paired differences.
+ *
+ * @param cfg Replica configuration (its `policy` field is ignored).
+ * @param policies Policies to compare; the first one is the baseline.
+ *
+ * @return int Process exit code.
+ *
+ * @details Replica `i` runs every policy on the same trip-time stream
+ *          `replica_seed(seed, i)`, so the per-replica differences cancel
+ *          the trip-time noise that dominates independent runs. A replica is
+ *          paired only if no policy stalled on it.
+ */
+int run_comparison(const ReplicaConfig &cfg, const std::vector<Policy> &policies) {
+    const std::size_t k = policies.size();
+    std::vector<std::vector<double>> makespans(k), meanWaits(k), missRates(k);
+    std::vector<long> stalledBy(k, 0);
+    long run = 0;
+    unsigned workers = worker_count(cfg.threads);
+
+    while (true) {
+        long count = std::min(cfg.replicas, cfg.maxReplicas - run);
+        if (count <= 0) break;
+
+        std::vector<std::vector<double>> ms(k, std::vector<double>(count));
+        std::vector<std::vector<double>> mw(k, std::vector<double>(count));
+        std::vector<std::vector<double>> mr(k, std::vector<double>(count));
+        std::vector<std::vector<char>> st(k, std::vector<char>(count));
+        parallel_for(count, workers, [&](long i, unsigned) {
+            auto seed = replica_seed(cfg.seed, run + i);
+            for (std::size_t j = 0; j < k; ++j) {
+                ReplicaResult r = simulate_replica(cfg.adults, cfg.children, seed, policies[j], cfg.triage);
+                ms[j][i] = static_cast<double>(r.makespan);
+                mw[j][i] = mean_wait(r);
+                mr[j][i] = miss_rate(r);
+                st[j][i] = r.stalled;
+            }
+        });
+
+        for (long i = 0; i < count; ++i) {
+            bool any = false;
+            for (std::size_t j = 0; j < k; ++j) {
+                if (st[j][i]) { stalledBy[j]++; any = true; }
+            }
+            if (any) continue;
+            for (std::size_t j = 0; j < k; ++j) {
+                makespans[j].push_back(ms[j][i]);
+                meanWaits[j].push_back(mw[j][i]);
+                missRates[j].push_back(mr[j][i]);
+            }
+        }
+        run += count;
+
+        if (cfg.ciWidth <= 0) break;
+        double widest = 0;
+        for (std::size_t j = 1; j < k; ++j) {
+            std::vector<double> d(makespans[0].size());
+            for (int q = 0; q < 2; ++q) {
+                auto &v = q ? meanWaits : makespans;
+                for (std::size_t i = 0; i < d.size(); ++i) d[i] = v[j][i] - v[0][i];
+                widest = std::max(widest, 2 * summarize(d).ciHalfWidth);
+            }
+        }
+        if (makespans[0].size() > 1 && widest <= cfg.ciWidth) break;
+    }
+
+    std::cout << "Policy Comparison (common random numbers)" << std::endl;
+    std::cout << "Adults: " << cfg.adults << ", children: " << cfg.children
+              << ", seed: " << cfg.seed << std::endl;
+    std::cout << "Replicas run: " << run << " (paired: " << makespans[0].size() << ")" << std::endl;
+    for (std::size_t j = 0; j < k; ++j) {
+        std::cout << policy_name(policies[j]) << (j == 0 ? " (baseline)" : "")
+                  << ", stalled replicas: " << stalledBy[j] << std::endl;
+        print_summary_line(std::cout, "  Makespan (s)", summarize(makespans[j]));
+        print_summary_line(std::cout, "  Mean wait (s)", summarize(meanWaits[j]));
+        if (cfg.triage.deadline > 0) print_summary_line(std::cout, "  Deadline misses (%)", summarize(missRates[j]));
+    }
+    for (std::size_t j = 1; j < k; ++j) {
+        std::cout << policy_name(policies[j]) << " - " << policy_name(policies[0]) << std::endl;
+        print_difference("Makespan (s)", makespans[0], makespans[j]);
+        print_difference("Mean wait (s)", meanWaits[0], meanWaits[j]);
+        if (cfg.triage.deadline > 0) print_difference("Deadline misses (%)", missRates[0], missRates[j]);
+    }
+    return makespans[0].empty() ? 1 : 0;
+}
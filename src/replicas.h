@@ -0,0 +1,46 @@
+/**
+ * @file src/replicas.h
+ *
+ * @brief Parallel Monte Carlo replicas of the model for makespan distributions.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#ifndef REPLICAS_H
+#define REPLICAS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "policy.h"
+#include "triage.h"
+
+/**
+ * @struct ReplicaConfig
+ *
+ * @brief What to run in `--replicas` mode.
+ *
+ * When `ciWidth` is positive, replicas keep being added in batches of
+ * `replicas` until the full width of the 95% CI of the mean makespan is at
+ * most `ciWidth` seconds, or `maxReplicas` have been run. In comparison mode
+ * the target applies to the widest CI of a paired difference instead.
+ * With deadlines in `triage`, every replica also reports the share of
+ * people who missed theirs.
+ */
+struct ReplicaConfig {
+    int adults = 0;
+    int children = 0;
+    std::uint64_t seed = 0;
+    long replicas = 0;
+    double ciWidth = 0;
+    long maxReplicas = 1000000;
+    unsigned threads = 0; // 0 = one per hardware thread
+    Policy policy = Policy::FIRST_FIT;
+    Triage triage; // its seed is replaced per replica
+};
+
+int run_replicas(const ReplicaConfig &cfg);
+int run_comparison(const ReplicaConfig &cfg, const std::vector<Policy> &policies);
+
+#endif
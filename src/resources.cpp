@@ -0,0 +1,166 @@
+/**
+ * @file src/resources.cpp
+ *
+ * @brief Process resource usage of one run (`--rusage`, `--rusage-json`).
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "resources.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sys/resource.h>
+
+/**
+ * @brief Read one `Key: value` number from /proc/self/status.
+ *
+ * @param key Field name including the colon, e.g. "Threads:".
+ *
+ * @return long The value (kB for memory fields), 0 if missing.
+ */
+static long proc_status(const char* key) {
+    std::FILE* f = std::fopen("/proc/self/status", "r");
+    if (!f) return 0;
+    char line[256];
+    long value = 0;
+    std::size_t n = std::strlen(key);
+    while (std::fgets(line, sizeof line, f)) {
+        if (std::strncmp(line, key, n) == 0) {
+            value = std::strtol(line + n, nullptr, 10);
+            break;
+        }
+    }
+    std::fclose(f);
+    return value;
+}
+
+/**
+ * @brief Seconds in a timeval.
+ *
+ * @param tv Time value.
+ *
+ * @return double Seconds.
+ */
+static double seconds(const timeval &tv) {
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/**
+ * @brief Record the baseline and start the thread-count sampler.
+ *
+ * @param sampleMs Sampling period of /proc/self/status.
+ *
+ * @return void
+ */
+void ResourceMonitor::start(int sampleMs) {
+    period = std::chrono::milliseconds(sampleMs);
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    user0 = seconds(ru.ru_utime);
+    sys0 = seconds(ru.ru_stime);
+    voluntary0 = ru.ru_nvcsw;
+    involuntary0 = ru.ru_nivcsw;
+    peakThreads = static_cast<int>(proc_status("Threads:"));
+    began = std::chrono::steady_clock::now();
+    sampler = std::thread(&ResourceMonitor::poll, this);
+}
+
+/**
+ * @brief Stop the sampler and fill in everything but the run description.
+ *
+ * @param out Usage to fill (`mode`, sizes, policy and trips are left alone).
+ *
+ * @return void
+ */
+void ResourceMonitor::stop(ResourceUsage &out) {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        stopping = true;
+    }
+    cv.notify_one();
+    sampler.join();
+    out.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    out.userSeconds = seconds(ru.ru_utime) - user0;
+    out.sysSeconds = seconds(ru.ru_stime) - sys0;
+    out.voluntarySwitches = ru.ru_nvcsw - voluntary0;
+    out.involuntarySwitches = ru.ru_nivcsw - involuntary0;
+    out.peakRssKb = proc_status("VmHWM:");
+    if (out.peakRssKb == 0) out.peakRssKb = ru.ru_maxrss;
+    out.peakThreads = peakThreads;
+}
+
+/**
+ * @brief Sampler thread: track the largest thread count seen.
+ *
+ * @return void
+ *
+ * @details Subtracts one for the sampler itself.
+ */
+void ResourceMonitor::poll() {
+    std::unique_lock<std::mutex> lk(mtx);
+    while (!cv.wait_for(lk, period, [&]{ return stopping; })) {
+        int threads = static_cast<int>(proc_status("Threads:")) - 1;
+        if (threads > peakThreads) peakThreads = threads;
+    }
+}
+
+/**
+ * @brief Print the resource usage section.
+ *
+ * @param os Output stream.
+ *
+ * @return void
+ */
+void ResourceUsage::print(std::ostream &os) const {
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize prec = os.precision();
+    os << "Resource Usage" << std::endl << std::fixed << std::setprecision(3);
+    os << "Wall time: " << wallSeconds << " s" << std::endl;
+    os << "CPU time: " << cpu_seconds() << " s (user " << userSeconds << ", sys " << sysSeconds << ")" << std::endl;
+    os << "Peak RSS: " << peakRssKb << " kB" << std::endl;
+    os << "Context switches: " << voluntarySwitches << " voluntary, " << involuntarySwitches << " involuntary" << std::endl;
+    os << "Peak threads: " << peakThreads << std::endl;
+    if (trips >= 0) {
+        os << std::setprecision(1) << "Trips per CPU-second: ";
+        if (cpu_seconds() > 0) os << trips_per_cpu_second() << std::endl;
+        else os << "n/a (under the clock resolution)" << std::endl;
+    }
+    os.flags(flags);
+    os.precision(prec);
+}
+
+/**
+ * @brief Write the usage as one JSON object.
+ *
+ * @param path Output file.
+ *
+ * @return true if the file was written.
+ *
+ * @details Counts without a meaning in this mode (`trips`,
+ *          `trips_per_cpu_s`) are `null`.
+ */
+bool ResourceUsage::write_json(const std::string &path) const {
+    std::ofstream os(path);
+    if (!os) return false;
+    os << std::setprecision(6);
+    os << "{\"mode\": \"" << mode << "\", \"adults\": " << adults << ", \"children\": " << children
+       << ", \"policy\": \"" << policy << "\", \"trips\": ";
+    if (trips >= 0) os << trips;
+    else os << "null";
+    os << ", \"wall_s\": " << wallSeconds << ", \"user_s\": " << userSeconds << ", \"sys_s\": " << sysSeconds
+       << ", \"cpu_s\": " << cpu_seconds() << ", \"peak_rss_kb\": " << peakRssKb
+       << ", \"voluntary_switches\": " << voluntarySwitches << ", \"involuntary_switches\": " << involuntarySwitches
+       << ", \"peak_threads\": " << peakThreads << ", \"trips_per_cpu_s\": ";
+    if (trips >= 0 && cpu_seconds() > 0) os << trips_per_cpu_second();
+    else os << "null";
+    os << "}" << std::endl;
+    return static_cast<bool>(os);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file src/resources.h
+ *
+ * @brief Process resource usage of one run (`--rusage`, `--rusage-json`).
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * `ResourceMonitor` brackets a run. CPU time and context switches are the
+ * getrusage deltas between `start()` and `stop()`; peak RSS is `VmHWM` from
+ * /proc/self/status. Linux keeps no peak thread count, so a sampler thread
+ * reads `Threads` from /proc/self/status every few milliseconds (itself not
+ * counted). Trips per CPU-second is the efficiency figure to compare across
+ * population sizes and modes.
+ */
+
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @struct ResourceUsage
+ *
+ * @brief What a run cost. `trips < 0` when the mode does not count trips.
+ */
+struct ResourceUsage {
+    std::string mode;
+    int adults = 0;
+    int children = 0;
+    std::string policy;
+    long trips = -1;
+    double wallSeconds = 0;
+    double userSeconds = 0;
+    double sysSeconds = 0;
+    long peakRssKb = 0;
+    long voluntarySwitches = 0;
+    long involuntarySwitches = 0;
+    int peakThreads = 0;
+
+    double cpu_seconds() const { return userSeconds + sysSeconds; }
+    double trips_per_cpu_second() const { return trips >= 0 && cpu_seconds() > 0 ? trips / cpu_seconds() : 0; }
+
+    void print(std::ostream &os) const;
+    bool write_json(const std::string &path) const;
+};
+
+/**
+ * @class ResourceMonitor
+ *
+ * @brief Measures the process from `start()` to `stop()`.
+ */
+class ResourceMonitor {
+public:
+    void start(int sampleMs = 5);
+    void stop(ResourceUsage &out);
+
+private:
+    void poll();
+
+    std::chrono::milliseconds period{5};
+    std::chrono::steady_clock::time_point began;
+    double user0 = 0, sys0 = 0;
+    long voluntary0 = 0, involuntary0 = 0;
+    int peakThreads = 0;
+
+    std::mutex mtx; // guards `stopping` and `peakThreads`
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread sampler;
+};
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * @file src/shadow.cpp
+ *
+ * @brief Shadow validator: checks every trip of the threaded run on its own thread.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "shadow.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+/**
+ * @brief Set up the mirror with everybody on the island.
+ *
+ * @param adults Number of adults.
+ * @param children Number of children.
+ * @param capacity Ring capacity in trips.
+ */
+ShadowValidator::ShadowValidator(int adults, int children, std::size_t capacity)
+    : ring(capacity), adults(adults), children(children), adultsOnIsland(adults), childrenOnIsland(children) {}
+
+/**
+ * @brief Stop the validator thread if it is still running.
+ */
+ShadowValidator::~ShadowValidator() { stop(); }
+
+/**
+ * @brief Start the validator thread.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void ShadowValidator::start() {
+    th = std::thread(&ShadowValidator::run, this);
+}
+
+/**
+ * @brief Check the remaining trips and stop the validator thread.
+ *
+ * @param void
+ *
+ * @return void
+ */
+void ShadowValidator::stop() {
+    if (!th.joinable()) return;
+    stopping.store(true, std::memory_order_release);
+    th.join();
+}
+
+/**
+ * @brief Validator thread body.
+ *
+ * @param void
+ *
+ * @return void
+ *
+ * @details Sleeps while the ring is empty: validation may lag the run, it
+ *          only must not slow it down.
+ */
+void ShadowValidator::run() {
+    TripEvent e;
+    while (true) {
+        bool last = stopping.load(std::memory_order_acquire);
+        std::size_t backlog = ring.size();
+        if (backlog > maxBacklog) maxBacklog = backlog;
+        bool any = false;
+        while (ring.try_pop(e)) { check(e); any = true; }
+        if (last) return;
+        if (!any) std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+}
+
+/**
+ * @brief Record a violation.
+ *
+ * @param e Trip that broke a rule.
+ * @param what Which rule.
+ *
+ * @return void
+ */
+void ShadowValidator::fail(const TripEvent &e, const std::string &what) {
+    violations++;
+    if (messages.size() < 10) messages.push_back("trip " + std::to_string(e.trip) + ": " + what);
+}
+
+/**
+ * @brief Check one trip against the mirror, then apply it.
+ *
+ * @param e Trip.
+ *
+ * @return void
+ */
+void ShadowValidator::check(const TripEvent &e) {
+    checked++;
+    auto who = [&](std::int32_t code) -> Mirror* {
+        std::vector<Mirror> &side = code > 0 ? adults : children;
+        std::size_t i = static_cast<std::size_t>(std::abs(code)) - 1;
+        return code != 0 && i < side.size() ? &side[i] : nullptr;
+    };
+    Loc from = static_cast<Loc>(e.from), to = from == ISLAND ? MAINLAND : ISLAND;
+    Mirror* d = who(e.driver);
+    Mirror* p = e.passenger ? who(e.passenger) : nullptr;
+
+    if (e.trip != checked) fail(e, "trips out of order or missing (expected " + std::to_string(checked) + ")");
+    if (!d || (e.passenger && !p)) { fail(e, "unknown person in the boat"); return; }
+    if (e.boarded > 2 || (p && e.driver == e.passenger)) fail(e, "boat over capacity");
+    if (e.driver > 0 && e.passenger > 0) fail(e, "two adults in the boat");
+    if (from != boatAt) fail(e, "boat left from the shore it is not at");
+    if (d->position != from || (p && p->position != from)) fail(e, "crew member not on the boat's shore");
+    if (e.driverRows != d->rows) {
+        fail(e, "driver's row count " + std::to_string(e.driverRows) + " differs from " + std::to_string(d->rows));
+    }
+    if (d->rows >= MAX_CONSECUTIVE) {
+        for (const Mirror &q : e.driver > 0 ? adults : children) {
+            if (&q != d && &q != p && q.position == from && q.rows < MAX_CONSECUTIVE) {
+                fail(e, "driver over the row limit while a rested person was on the shore");
+                break;
+            }
+        }
+    }
+
+    for (Mirror* x : {d, p}) {
+        if (!x) continue;
+        x->position = to;
+        int &count = (x >= adults.data() && x < adults.data() + adults.size()) ? adultsOnIsland : childrenOnIsland;
+        count += to == ISLAND ? 1 : -1;
+    }
+    d->rows++;
+    if (p) p->rows = 0;
+    boatAt = to;
+    if (e.adultsOnIsland != adultsOnIsland || e.childrenOnIsland != childrenOnIsland) {
+        std::ostringstream os;
+        os << "island counts " << e.adultsOnIsland << "/" << e.childrenOnIsland << " differ from "
+           << adultsOnIsland << "/" << childrenOnIsland;
+        fail(e, os.str());
+    }
+}
+
+/**
+ * @brief Print what the validator checked and found.
+ *
+ * @param os Output stream.
+ *
+ * @return void
+ */
+void ShadowValidator::print(std::ostream &os) const {
+    os << "Shadow validator" << std::endl;
+    os << "Trips checked: " << checked << ", violations: " << violations << ", largest backlog: " << maxBacklog
+       << ", full-ring waits: " << overflows << std::endl;
+    for (const std::string &m : messages) os << "  " << m << std::endl;
+}
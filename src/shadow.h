@@ -0,0 +1,113 @@
+/**
+ * @file src/shadow.h
+ *
+ * @brief Shadow validator: checks every trip of the threaded run on its own thread.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The driver of each trip fills one `TripEvent` while it still holds
+ * `Boat::mtx` and pushes it into an `MpmcQueue`, which costs a few stores
+ * and one CAS. A validator thread drains the ring and replays the trips on
+ * its own mirror of the shores, checking:
+ *
+ * - capacity: at most two people boarded, and a distinct driver;
+ * - composition: never two adults in the boat;
+ * - shore counts: the boat leaves from where it is, the crew is on that
+ *   shore, and the island counts reported by the engine equal the mirror's
+ *   (everyone is always on exactly one shore);
+ * - rowing limits: the driver's row count matches the mirror, and a driver
+ *   who has already rowed `MAX_CONSECUTIVE` times in a row only rows again
+ *   when no rested person of the same age is on that shore.
+ *
+ * A full ring never drops an event: the driver yields until there is room
+ * and the overflow is counted.
+ */
+
+#ifndef SHADOW_H
+#define SHADOW_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "island.h"
+#include "mpmc.h"
+
+/**
+ * @struct TripEvent
+ *
+ * @brief One completed trip, as the driver saw it before its bookkeeping.
+ *
+ * People are coded like the flight recorder: +id for an adult, -id for a
+ * child, 0 for no passenger.
+ */
+struct TripEvent {
+    std::int32_t trip = 0;        // 1-based trip number
+    std::int32_t driver = 0, passenger = 0;
+    std::int32_t driverRows = 0;  // driver's consecutive rows before this trip
+    std::int32_t boarded = 0;     // Boat::boardedCount at departure
+    std::int32_t adultsOnIsland = 0, childrenOnIsland = 0; // after the trip
+    std::uint8_t from = ISLAND;
+};
+
+/**
+ * @class ShadowValidator
+ *
+ * @brief Validator thread running from `start()` to `stop()`.
+ */
+class ShadowValidator {
+public:
+    ShadowValidator(int adults, int children, std::size_t capacity = 1 << 14);
+    ~ShadowValidator();
+
+    ShadowValidator(const ShadowValidator &) = delete;
+    ShadowValidator &operator=(const ShadowValidator &) = delete;
+
+    void start();
+    void stop();
+
+    /**
+     * @brief Hand one trip to the validator (called by the driver under `Boat::mtx`).
+     *
+     * @param e Trip.
+     *
+     * @return void
+     */
+    void post(const TripEvent &e) {
+        if (ring.try_push(e)) return;
+        overflows++;
+        while (!ring.try_push(e)) std::this_thread::yield();
+    }
+
+    long trips() const { return checked; }
+    long violation_count() const { return violations; }
+    const std::vector<std::string> &first_violations() const { return messages; }
+    void print(std::ostream &os) const;
+
+private:
+    void run();
+    void check(const TripEvent &e);
+    void fail(const TripEvent &e, const std::string &what);
+
+    MpmcQueue<TripEvent> ring;
+    std::atomic<bool> stopping{false};
+    std::thread th;
+    long overflows = 0; // written by drivers, which are serialized by Boat::mtx
+
+    // mirror of the shores, validator thread only
+    struct Mirror { Loc position = ISLAND; int rows = 0; };
+    std::vector<Mirror> adults, children;
+    Loc boatAt = ISLAND;
+    int adultsOnIsland = 0, childrenOnIsland = 0;
+    long checked = 0, violations = 0;
+    std::size_t maxBacklog = 0;
+    std::vector<std::string> messages; // first few violations
+};
+
+#endif
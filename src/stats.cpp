@@ -0,0 +1,144 @@
+/**
+ * @file src/stats.cpp
+ *
+ * @brief Summary statistics (mean, confidence interval, percentiles) for simulation samples.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+/**
+ * @brief Two-sided 95% critical value of Student's t distribution.
+ *
+ * @param df Degrees of freedom.
+ *
+ * @return double Critical value; the normal 1.96 once df is large.
+ */
+static double t95(std::size_t df) {
+    static const double table[] = {
+        0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df == 0) return 0;
+    if (df <= 30) return table[df];
+    return 1.96;
+}
+
+/**
+ * @brief Nearest-rank percentile of an already sorted sample.
+ *
+ * @param sorted Sample sorted ascending.
+ * @param q Quantile in [0,1].
+ *
+ * @return double The percentile, or 0 for an empty sample.
+ */
+double percentile(const std::vector<double> &sorted, double q) {
+    if (sorted.empty()) return 0;
+    std::size_t rank = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+    if (rank == 0) rank = 1;
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+/**
+ * @brief Compute descriptive statistics of a sample.
+ *
+ * @param samples Sample values (taken by value because they get sorted).
+ *
+ * @return Summary Mean, standard deviation, 95% CI half width and percentiles.
+ */
+Summary summarize(std::vector<double> samples) {
+    Summary s;
+    s.n = samples.size();
+    if (samples.empty()) return s;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double v : samples) sum += v;
+    s.mean = sum / s.n;
+
+    double sq = 0;
+    for (double v : samples) sq += (v - s.mean) * (v - s.mean);
+    s.stddev = s.n > 1 ? std::sqrt(sq / (s.n - 1)) : 0;
+    s.ciHalfWidth = s.n > 1 ? t95(s.n - 1) * s.stddev / std::sqrt(static_cast<double>(s.n)) : 0;
+
+    s.min = samples.front();
+    s.max = samples.back();
+    s.p50 = percentile(samples, 0.50);
+    s.p90 = percentile(samples, 0.90);
+    s.p99 = percentile(samples, 0.99);
+    return s;
+}
+
+/**
+ * @brief Record `times` occurrences of `value`.
+ *
+ * @param value Non-negative sample value.
+ * @param times Number of occurrences.
+ *
+ * @return void
+ */
+void IntHistogram::add(long value, std::uint64_t times) {
+    if (value < 0) value = 0;
+    if (static_cast<std::size_t>(value) >= counts.size()) counts.resize(value + 1, 0);
+    counts[value] += times;
+    total += times;
+}
+
+/**
+ * @brief Add all counts of another histogram to this one.
+ *
+ * @param other Histogram to merge in.
+ *
+ * @return void
+ */
+void IntHistogram::merge(const IntHistogram &other) {
+    if (other.counts.size() > counts.size()) counts.resize(other.counts.size(), 0);
+    for (std::size_t i = 0; i < other.counts.size(); ++i) counts[i] += other.counts[i];
+    total += other.total;
+}
+
+/**
+ * @brief Nearest-rank percentile of the recorded samples.
+ *
+ * @param q Quantile in [0,1].
+ *
+ * @return long The percentile, or 0 when the histogram is empty.
+ */
+long IntHistogram::percentile(double q) const {
+    if (total == 0) return 0;
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(q * total));
+    if (rank == 0) rank = 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) return static_cast<long>(i);
+    }
+    return static_cast<long>(counts.size()) - 1;
+}
+
+/**
+ * @brief Print one summary as a single labelled line.
+ *
+ * @param os Output stream.
+ * @param label Name of the measured quantity.
+ * @param s Summary to print.
+ *
+ * @return void
+ */
+void print_summary_line(std::ostream &os, const char *label, const Summary &s) {
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize prec = os.precision();
+    os << std::fixed << std::setprecision(2)
+       << label << ": mean " << s.mean << " +/- " << s.ciHalfWidth << " (95% CI)"
+       << ", p50 " << s.p50 << ", p90 " << s.p90 << ", p99 " << s.p99
+       << ", min " << s.min << ", max " << s.max << std::endl;
+    os.flags(flags);
+    os.precision(prec);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file src/stats.h
+ *
+ * @brief Summary statistics (mean, confidence interval, percentiles) for simulation samples.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @struct Summary
+ *
+ * @brief Descriptive statistics of a sample.
+ *
+ * `ciHalfWidth` is the half width of the 95% confidence interval of the mean,
+ * so the interval is `mean ± ciHalfWidth`.
+ */
+struct Summary {
+    std::size_t n = 0;
+    double mean = 0, stddev = 0, ciHalfWidth = 0;
+    double min = 0, p50 = 0, p90 = 0, p99 = 0, max = 0;
+};
+
+/**
+ * @struct IntHistogram
+ *
+ * @brief Exact histogram of non-negative integer samples.
+ *
+ * Trip times are whole seconds, so makespans and waits are integers; keeping
+ * counts per value gives exact percentiles in memory bounded by the largest
+ * value instead of the number of samples.
+ */
+struct IntHistogram {
+    std::vector<std::uint64_t> counts;
+    std::uint64_t total = 0;
+
+    void add(long value, std::uint64_t times = 1);
+    void merge(const IntHistogram &other);
+    long percentile(double q) const;
+};
+
+Summary summarize(std::vector<double> samples);
+double percentile(const std::vector<double> &sorted, double q);
+void print_summary_line(std::ostream &os, const char *label, const Summary &s);
+
+#endif
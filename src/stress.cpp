@@ -0,0 +1,550 @@
+/**
+ * @file src/stress.cpp
+ *
+ * @brief Differential stress test of the threaded engine against the sequential model.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Every case draws adults, children, a seed, a policy and triage settings
+ * from the base seed and the case index, then runs the same configuration
+ * three times:
+ *
+ * - the threaded engine (`run_simulation`) with zero-length trips, so it
+ *   runs in virtual time: `Boat::clock` still advances by each drawn trip
+ *   time;
+ * - the `Ferry` model, fed the same trip-time stream;
+ * - `Reference`, a naive model written here that shares no selection code
+ *   with the other two: every pick is a plain scan over everybody, fifo by
+ *   the time each person reached their shore and priority and edf by the
+ *   triage key. A bug in `policy.h`, `dock.h` or `triage.h` would show up
+ *   in both the engine and `Ferry`, but not here.
+ *
+ * Each model trip is checked against the rules as it is planned: at most
+ * two people, never two adults, the crew free and on the boat's shore, and
+ * a driver over `MAX_CONSECUTIVE` only when no rested person of the same
+ * age was available. The engine's trips get the same checks from the
+ * shadow validator (`shadow.h`). Then the engine and `Ferry` must each
+ * agree with the reference on every `print_summary` counter and on every
+ * person's final position, row count, break flag and landing time, and all
+ * must end with everybody on the mainland.
+ *
+ * One case in eight also injects stragglers and, in half of those, boarding
+ * timeouts, on 100 us trips. Replaced crew members make the crews depend on
+ * thread timing, so such a case is only checked for invariants: no shadow
+ * violation, everybody on the mainland and consistent counters.
+ *
+ * Cases run in parallel across cores. A case that hangs is reported by a
+ * monitor thread, which exits the process with the reproduction command.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "engine.h"
+#include "model.h"
+#include "parallel.h"
+#include "shadow.h"
+
+// the engine as in the lean build, plus stragglers and boarding timeouts, the
+// shadow validator and the waiting lines of the fifo, priority and edf policies
+using StressInstrumentation = Instrumentation<false, false, false, false, false, false, true, false, true, true>;
+
+/**
+ * @struct StressCase
+ *
+ * @brief One configuration to run through both implementations.
+ */
+struct StressCase {
+    int adults = 0, children = 0;
+    std::mt19937::result_type seed = 0;
+    Policy policy = Policy::FIRST_FIT;
+    Triage triage;
+    double straggle = 0, boardingTimeout = 0; // fault injection, in trip-time units
+};
+
+static const Policy allPolicies[] = {Policy::FIRST_FIT, Policy::LEAST_ROWED, Policy::ROUND_ROBIN,
+                                     Policy::FIFO, Policy::PRIORITY, Policy::EDF};
+
+/**
+ * @brief Draw case `index` of a run.
+ *
+ * @param base Base seed of the run.
+ * @param index Case index.
+ * @param maxAdults Largest number of adults.
+ * @param maxExtra Largest number of children beyond the minimum for the adults.
+ *
+ * @return StressCase The case (a valid command line for `bin/island`).
+ */
+static StressCase make_case(std::uint64_t base, long index, int maxAdults, int maxExtra) {
+    StressCase c;
+    c.seed = replica_seed(base, static_cast<std::uint64_t>(index));
+    std::mt19937 rng(c.seed);
+    c.adults = std::uniform_int_distribution<int>(1, maxAdults)(rng);
+    c.children = c.adults + 1 + std::uniform_int_distribution<int>(0, maxExtra)(rng);
+    c.policy = allPolicies[std::uniform_int_distribution<int>(0, 5)(rng)];
+    c.triage.classes = std::uniform_int_distribution<int>(1, 3)(rng);
+    c.triage.deadline = std::uniform_int_distribution<int>(0, 1)(rng) ? 30 : 0;
+    c.triage.seed = c.seed;
+    if (std::uniform_int_distribution<int>(0, 7)(rng) == 0) {
+        c.straggle = 0.2;
+        c.boardingTimeout = std::uniform_int_distribution<int>(0, 1)(rng) ? 0.5 : 0;
+    }
+    return c;
+}
+
+static const double STRAGGLE_TIME = 2;                          // trip-time units
+static const std::chrono::microseconds FAULT_UNIT{100};         // trip-time unit of fault cases
+
+/**
+ * @brief Command line that reruns the threaded side of a case.
+ *
+ * @param c Case.
+ *
+ * @return std::string `bin/island` invocation.
+ */
+static std::string reproduce(const StressCase &c) {
+    std::ostringstream os;
+    os << "./bin/island " << c.adults << " " << c.children << " --seed " << c.seed << " --policy "
+       << policy_name(c.policy) << " --time-scale " << (c.straggle > 0 ? 1e-6 * FAULT_UNIT.count() : 0);
+    if (c.triage.classes > 1) os << " --priority-classes " << c.triage.classes;
+    if (c.triage.deadline > 0) os << " --deadline " << c.triage.deadline;
+    if (c.straggle > 0) os << " --straggle " << c.straggle << " --straggle-time " << STRAGGLE_TIME;
+    if (c.boardingTimeout > 0) os << " --boarding-timeout " << c.boardingTimeout;
+    return os.str();
+}
+
+/**
+ * @brief Check a planned model trip against the crossing rules.
+ *
+ * @param ferry Model, before the trip is finished.
+ * @param trip Planned trip.
+ *
+ * @return std::string Empty if the trip is legal, otherwise what is wrong.
+ */
+static std::string check_trip(const Ferry &ferry, const Trip &trip) {
+    const SimPerson* d = trip.driver;
+    const SimPerson* p = trip.passenger;
+    if (!d || d == p) return "trip without a distinct driver";
+    if (trip.from != ferry.location) return "boat left from the wrong shore";
+    if (p && d->isAdult && p->isAdult) return "two adults in the boat";
+    for (const SimPerson* x : {d, p}) {
+        if (x && x->position != trip.from) return "crew member not on the boat's shore";
+    }
+    if (d->consecutiveRows >= MAX_CONSECUTIVE) {
+        for (const SimPerson &q : ferry.people) {
+            if (&q != d && &q != p && q.role == SimPerson::NONE && q.isAdult == d->isAdult &&
+                q.position == trip.from && q.consecutiveRows < MAX_CONSECUTIVE) {
+                return "driver over the row limit while a rested person was free";
+            }
+        }
+    }
+    return {};
+}
+
+/**
+ * @struct RefPerson
+ *
+ * @brief A person as the naive reference sees them.
+ */
+struct RefPerson {
+    int id = 0;
+    bool isAdult = false;
+    Loc position = ISLAND;
+    bool busy = false; // in the crew being formed
+    int consecutiveRows = 0;
+    bool needsBreak = false;
+    int priority = 0;
+    double deadline = 0;
+    double landedAt = 0;
+    std::uint64_t reached = 0; // when they last reached their shore (fifo)
+};
+
+/**
+ * @class Reference
+ *
+ * @brief Naive sequential model: the controller's crew steps over plain scans.
+ *
+ * Written from the rules rather than from `Ferry`, and without `policy.h`,
+ * `dock.h` or `triage.h` selection code. Each pick looks at everybody, so it
+ * is O(people), which is fine for stress-sized cases.
+ */
+class Reference {
+public:
+    Reference(const StressCase &c) : adultsOnIsland(c.adults), childrenOnIsland(c.children), policy(c.policy) {
+        for (int i = 0; i < c.adults + c.children; ++i) {
+            RefPerson p;
+            p.isAdult = i < c.adults;
+            p.id = p.isAdult ? i + 1 : i - c.adults + 1;
+            p.reached = reached++;
+            people.push_back(p);
+        }
+        assign_triage(people, c.triage);
+    }
+
+    /**
+     * @brief Evacuate everybody, drawing trip times like `Boat::tripTime`.
+     *
+     * @param seed Seed of the trip-time stream.
+     *
+     * @return void
+     */
+    void run(std::mt19937::result_type seed) {
+        rng.seed(seed);
+        // adult cycle: two children over, one back, child and adult over, one back
+        while (adultsOnIsland > 0) {
+            RefPerson* c1 = pick(false, ISLAND, false, true);
+            RefPerson* c2 = c1 ? pick(false, ISLAND, false, false) : nullptr;
+            if (!c1 || !c2) { requeue(c1); break; }
+            cross(c1, c2);
+            if (!row_back()) break;
+            RefPerson* adult = pick(true, ISLAND, false, true);
+            RefPerson* child = pick(false, ISLAND, false, true);
+            if (!adult || !child) { requeue(adult); requeue(child); break; }
+            cross(child, adult);
+            if (adultsOnIsland == 0 && childrenOnIsland == 0) break;
+            if (!row_back()) break;
+        }
+        // children: pairs while there are two, then one alone
+        while (childrenOnIsland > 0) {
+            if (location == MAINLAND) {
+                if (!row_back()) break;
+                continue;
+            }
+            RefPerson* c1 = pick(false, ISLAND, false, true);
+            RefPerson* c2 = c1 && childrenOnIsland >= 2 ? pick(false, ISLAND, false, false) : nullptr;
+            if (!c1 || (childrenOnIsland >= 2 && !c2)) { requeue(c1); break; }
+            cross(c1, c2);
+        }
+    }
+
+    std::vector<RefPerson> people;
+    Loc location = ISLAND;
+    int adultsOnIsland, childrenOnIsland;
+    int tripsToMain = 0, tripsToIsland = 0;
+    int twokidBoats = 0, kidAdultBoats = 0, soloBoats = 0;
+    int adultDrivers = 0, childDrivers = 0;
+    double clock = 0;
+
+private:
+    // true if `a` goes before `b` on shore `where`
+    bool before(const RefPerson &a, const RefPerson &b, Loc where) const {
+        if (policy == Policy::FIFO) return a.reached < b.reached;
+        double inf = std::numeric_limits<double>::infinity();
+        double da = a.deadline > 0 ? a.deadline : inf, db = b.deadline > 0 ? b.deadline : inf;
+        double pa = a.priority, pb = b.priority;
+        auto ka = policy == Policy::EDF ? std::make_tuple(da, pa, a.id) : std::make_tuple(pa, da, a.id);
+        auto kb = policy == Policy::EDF ? std::make_tuple(db, pb, b.id) : std::make_tuple(pb, db, b.id);
+        // the most urgent leaves the island first, the least urgent rows back
+        return where == ISLAND ? ka < kb : kb < ka;
+    }
+
+    /**
+     * @brief Pick a free person, marking them busy.
+     *
+     * @param adult Age wanted.
+     * @param where Shore.
+     * @param excludeNeedsBreak Skip people who need a break.
+     * @param preferRested Look at people below `MAX_CONSECUTIVE` first.
+     *
+     * @return RefPerson* The person, or nullptr.
+     */
+    RefPerson* pick(bool adult, Loc where, bool excludeNeedsBreak, bool preferRested) {
+        const std::size_t n = people.size();
+        auto free = [&](const RefPerson &p) {
+            return p.isAdult == adult && p.position == where && !p.busy && !(excludeNeedsBreak && p.needsBreak);
+        };
+        RefPerson* best = nullptr;
+        if (policy == Policy::LEAST_ROWED) {
+            for (RefPerson &p : people)
+                if (free(p) && (!best || p.consecutiveRows < best->consecutiveRows)) best = &p;
+        } else if (policy == Policy::FIRST_FIT || policy == Policy::ROUND_ROBIN) {
+            std::size_t start = policy == Policy::ROUND_ROBIN ? cursor % n : 0;
+            for (int pass = preferRested ? 0 : 1; pass < 2 && !best; ++pass) {
+                for (std::size_t k = 0; k < n && !best; ++k) {
+                    std::size_t i = (start + k) % n;
+                    if (free(people[i]) && (pass == 1 || people[i].consecutiveRows < MAX_CONSECUTIVE)) {
+                        best = &people[i];
+                        if (policy == Policy::ROUND_ROBIN) cursor = i + 1;
+                    }
+                }
+            }
+        } else {
+            for (int pass = preferRested ? 0 : 1; pass < 2 && !best; ++pass) {
+                for (RefPerson &p : people)
+                    if (free(p) && (pass == 1 || p.consecutiveRows < MAX_CONSECUTIVE) && (!best || before(p, *best, where)))
+                        best = &p;
+            }
+        }
+        if (best) best->busy = true;
+        return best;
+    }
+
+    // a person picked for a crew that fell through; fifo queues them again
+    void requeue(RefPerson* p) {
+        if (!p) return;
+        p->busy = false;
+        if (policy == Policy::FIFO) p->reached = reached++;
+    }
+
+    bool row_back() {
+        RefPerson* rc = pick(false, MAINLAND, false, true);
+        if (!rc) rc = pick(true, MAINLAND, false, true);
+        if (!rc) return false;
+        cross(rc, nullptr);
+        return true;
+    }
+
+    void cross(RefPerson* driver, RefPerson* passenger) {
+        int t = std::uniform_int_distribution<int>{1, 4}(rng);
+        clock += t;
+        Loc from = location;
+        location = from == ISLAND ? MAINLAND : ISLAND;
+        for (RefPerson* p : {driver, passenger}) {
+            if (!p) continue;
+            int &count = p->isAdult ? adultsOnIsland : childrenOnIsland;
+            count += from == ISLAND ? -1 : 1;
+            p->position = location;
+            if (from == ISLAND) p->landedAt = clock;
+        }
+        (from == ISLAND ? tripsToMain : tripsToIsland)++;
+        if (!passenger) soloBoats++;
+        else if (driver->isAdult || passenger->isAdult) kidAdultBoats++;
+        else twokidBoats++;
+        (driver->isAdult ? adultDrivers : childDrivers)++;
+        if (++driver->consecutiveRows >= MAX_CONSECUTIVE) driver->needsBreak = true;
+        if (passenger) { passenger->consecutiveRows = 0; passenger->needsBreak = false; }
+        for (RefPerson* p : {driver, passenger}) {
+            if (!p) continue;
+            p->busy = false;
+            p->reached = reached++;
+        }
+    }
+
+    Policy policy;
+    std::size_t cursor = 0;
+    std::uint64_t reached = 0;
+    std::mt19937 rng;
+};
+
+/**
+ * @brief Compare a finished run with the reference.
+ *
+ * @param name "engine" or "model".
+ * @param run Boat or Ferry after the run.
+ * @param clock Its virtual makespan.
+ * @param people Its people, in creation order.
+ * @param ref Reference after the run.
+ *
+ * @return std::string Empty if they agree, otherwise the first difference.
+ */
+template <class Run, class People>
+static std::string differ(const char* name, const Run &run, double clock, People &people, const Reference &ref) {
+    std::ostringstream why;
+    const std::pair<const char*, std::pair<int, int>> counters[] = {
+        {"trips to the mainland", {run.tripsToMain, ref.tripsToMain}},
+        {"trips to the island", {run.tripsToIsland, ref.tripsToIsland}},
+        {"boats with 2 children", {run.twokidBoats, ref.twokidBoats}},
+        {"boats with 1 child and 1 adult", {run.kidAdultBoats, ref.kidAdultBoats}},
+        {"boats with 1 person", {run.soloBoats, ref.soloBoats}},
+        {"adult drivers", {run.adultDrivers, ref.adultDrivers}},
+        {"child drivers", {run.childDrivers, ref.childDrivers}},
+    };
+    for (auto &cnt : counters) {
+        if (cnt.second.first != cnt.second.second) {
+            why << cnt.first << ": " << name << " " << cnt.second.first << ", reference " << cnt.second.second;
+            return why.str();
+        }
+    }
+    if (clock != ref.clock) {
+        why << "virtual makespan: " << name << " " << clock << ", reference " << ref.clock;
+        return why.str();
+    }
+    for (std::size_t i = 0; i < people.size(); ++i) {
+        auto e = as_ptr(people[i]);
+        const RefPerson &m = ref.people[i];
+        if (e->position != m.position || e->consecutiveRows != m.consecutiveRows || e->needsBreak != m.needsBreak ||
+            e->landedAt != m.landedAt) {
+            why << (e->isAdult ? "adult " : "child ") << e->id << " differs: " << name << " rows " << e->consecutiveRows
+                << (e->needsBreak ? " (break)" : "") << " landed " << e->landedAt << ", reference rows "
+                << m.consecutiveRows << (m.needsBreak ? " (break)" : "") << " landed " << m.landedAt;
+            return why.str();
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Run one case through the engine, the model and the reference and compare them.
+ *
+ * @param c Case.
+ *
+ * @return std::string Empty if everything matched, otherwise the first difference.
+ */
+static std::string run_case(const StressCase &c) {
+    std::ostringstream why;
+    bool faults = c.straggle > 0;
+
+    // the model in virtual time, checking every trip
+    Ferry ferry(c.adults, c.children, c.policy, c.triage);
+    std::mt19937 tripRng(c.seed);
+    std::uniform_int_distribution<int> dist{1,4};
+    double clock = 0;
+    Trip trip;
+    while (ferry.plan(trip)) {
+        std::string bad = check_trip(ferry, trip);
+        if (!bad.empty()) return "model trip " + std::to_string(ferry.tripsToMain + ferry.tripsToIsland + 1) + ": " + bad;
+        int t = dist(tripRng);
+        clock += t;
+        ferry.finish(trip, clock - t, clock);
+    }
+    // a stalled model means the threaded run would hang
+    if (ferry.stalled()) return "model stalled with people on the island";
+
+    // threaded engine with zero-length trips, or short ones when faults are injected
+    std::ostream discard(nullptr);
+    Boat boat;
+    boat.adultsOnIsland = c.adults;
+    boat.childrenOnIsland = c.children;
+    boat.out = &discard;
+    boat.tripUnit = faults ? FAULT_UNIT : std::chrono::microseconds(0);
+    boat.rng.seed(c.seed);
+    boat.policy = c.policy;
+    boat.straggleRate = c.straggle;
+    boat.straggleTime = STRAGGLE_TIME;
+    boat.boardingTimeout = c.boardingTimeout;
+    boat.faultRng.seed(static_cast<std::mt19937::result_type>(c.seed ^ 0x5DEECE66DULL));
+    auto people = init_people(&boat, c.adults, c.children, c.triage);
+    ShadowValidator shadow(c.adults, c.children);
+    boat.shadow = &shadow;
+    shadow.start();
+    run_simulation<StressInstrumentation>(boat, people);
+    shadow.stop();
+
+    if (shadow.violation_count() > 0) return "engine " + shadow.first_violations().front();
+
+    if (boat.adultsOnIsland != 0 || boat.childrenOnIsland != 0) {
+        why << "engine ended with " << boat.adultsOnIsland << " adults, " << boat.childrenOnIsland << " children on the island";
+        return why.str();
+    }
+    int trips = boat.tripsToMain + boat.tripsToIsland;
+    if (boat.twokidBoats + boat.kidAdultBoats + boat.soloBoats != trips || boat.adultDrivers + boat.childDrivers != trips ||
+        boat.tripsToMain != boat.tripsToIsland + 1) {
+        return "engine boat, driver or direction counts do not add up to its trips";
+    }
+    for (auto &p : people) {
+        if (p->position != MAINLAND) {
+            why << "engine left " << (p->isAdult ? "adult " : "child ") << p->id << " on the island";
+            return why.str();
+        }
+    }
+    // replaced crews depend on thread timing: the invariants are all there is to check
+    if (faults) return {};
+
+    Reference ref(c);
+    ref.run(c.seed);
+    if (ref.adultsOnIsland != 0 || ref.childrenOnIsland != 0) return "reference stalled with people on the island";
+    std::string bad = differ("engine", boat, boat.clock, people, ref);
+    if (bad.empty()) bad = differ("model", ferry, clock, ferry.people, ref);
+    return bad;
+}
+
+/**
+ * @brief Entry point: `./bin/stress [--cases N] [--seed S] [--threads T] [--max-adults N] [--max-extra N] [--hang S]`.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ *
+ * @return int 0 if every case matched, 1 on bad arguments or a mismatch, 2 on a hang.
+ */
+int main(int argc, char** argv) {
+    long cases = 2000;
+    std::uint64_t seed = 1;
+    unsigned threads = 0;
+    int maxAdults = 12, maxExtra = 20;
+    double hang = 10;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool more = i + 1 < argc;
+            if (arg == "--cases" && more) cases = std::stol(argv[++i]);
+            else if (arg == "--seed" && more) seed = std::stoull(argv[++i]);
+            else if (arg == "--threads" && more) threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            else if (arg == "--max-adults" && more) maxAdults = std::stoi(argv[++i]);
+            else if (arg == "--max-extra" && more) maxExtra = std::stoi(argv[++i]);
+            else if (arg == "--hang" && more) hang = std::stod(argv[++i]);
+            else throw 0;
+        }
+    } catch (...) {
+        std::cerr << "usage: ./bin/stress [--cases N] [--seed S] [--threads T] [--max-adults N] [--max-extra N] [--hang S]" << std::endl;
+        return 1;
+    }
+    if (cases <= 0 || maxAdults < 1 || maxExtra < 0 || hang <= 0) {
+        std::cerr << "need cases > 0, max-adults >= 1, max-extra >= 0 and hang > 0" << std::endl;
+        return 1;
+    }
+    unsigned workers = worker_count(threads);
+
+    // hang monitor: each worker publishes the case it is running and since when
+    struct Slot { std::atomic<long> index{-1}; std::atomic<std::int64_t> since{0}; };
+    std::vector<Slot> running(workers);
+    std::atomic<bool> done{false};
+    auto now_ms = []() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+    std::thread monitor([&]() {
+        while (!done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            for (auto &s : running) {
+                long i = s.index.load();
+                if (i >= 0 && now_ms() - s.since.load() > static_cast<std::int64_t>(1000 * hang)) {
+                    std::cerr << "case " << i << " hung for " << hang << " s: " << reproduce(make_case(seed, i, maxAdults, maxExtra)) << std::endl;
+                    std::_Exit(2);
+                }
+            }
+        }
+    });
+
+    std::mutex failMtx;
+    std::vector<std::pair<long, std::string>> failures;
+    auto t0 = std::chrono::steady_clock::now();
+    parallel_for(cases, workers, [&](long i, unsigned w) {
+        StressCase c = make_case(seed, i, maxAdults, maxExtra);
+        running[w].since.store(now_ms());
+        running[w].index.store(i);
+        std::string bad = run_case(c);
+        running[w].index.store(-1);
+        if (!bad.empty()) {
+            std::lock_guard<std::mutex> lk(failMtx);
+            failures.emplace_back(i, bad);
+        }
+    }, 1);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    done = true;
+    monitor.join();
+
+    std::sort(failures.begin(), failures.end());
+    std::cout << "Stress: " << cases << " cases (up to " << maxAdults << " adults, " << maxExtra
+              << " extra children, all policies), seed " << seed << ", " << workers << " threads" << std::endl;
+    std::cout << "Failures: " << failures.size() << ", " << static_cast<long>(cases / secs) << " cases per second" << std::endl;
+    for (std::size_t k = 0; k < failures.size() && k < 10; ++k) {
+        StressCase c = make_case(seed, failures[k].first, maxAdults, maxExtra);
+        std::cout << "case " << failures[k].first << ": " << failures[k].second << std::endl
+                  << "  " << reproduce(c) << std::endl;
+    }
+    return failures.empty() ? 0 : 1;
+}
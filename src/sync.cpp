@@ -0,0 +1,395 @@
+/**
+ * @file src/sync.cpp
+ *
+ * @brief Controlled scheduler behind the instrumented primitives of `sync.h`.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * Only built into `bin/island-explore`, with `-DISLAND_EXPLORE`. Managed
+ * threads are real threads, but each waits on its own condition variable
+ * until the scheduler hands it the turn, so exactly one of them runs at a
+ * time. All scheduler state is guarded by `g_mtx`.
+ */
+
+#include "sync.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @struct Slot
+ *
+ * @brief Scheduler view of one managed thread.
+ */
+struct Slot {
+    enum State { RUNNABLE, BLOCKED, DONE } state = RUNNABLE;
+    enum Wait { NONE, MUTEX, CV, JOIN } wait = NONE;
+    const void* on = nullptr; // the mutex, cv or slot waited for
+    bool timed = false, timedOut = false;
+    long priority = 0;
+    std::string name;
+    std::condition_variable turn;
+};
+
+static std::mutex g_mtx;
+static std::vector<std::unique_ptr<Slot>> g_slots;
+static int g_current = -1;
+static bool g_aborted = false;
+static ExploreOptions g_opts;
+static ExploreResult g_result;
+static std::mt19937_64 g_rng;
+static std::vector<long> g_changes; // pct priority change points
+static thread_local int t_self = -1;
+
+/**
+ * @brief Make a blocked thread runnable again.
+ *
+ * @param s Slot.
+ *
+ * @return void
+ */
+static void wake(Slot &s) {
+    s.state = Slot::RUNNABLE;
+    s.wait = Slot::NONE;
+    s.on = nullptr;
+}
+
+/**
+ * @brief Describe every unfinished thread for a deadlock report.
+ *
+ * @param void
+ *
+ * @return std::string One line per thread.
+ */
+static std::string describe_blocked() {
+    std::string out;
+    for (auto &s : g_slots) {
+        if (s->state == Slot::DONE) continue;
+        out += "  " + s->name + ": ";
+        switch (s->wait) {
+        case Slot::MUTEX: out += "waiting for a mutex"; break;
+        case Slot::CV: out += s->timed ? "in a timed cv wait" : "in a cv wait"; break;
+        case Slot::JOIN: out += "joining " + static_cast<const Slot*>(s->on)->name; break;
+        case Slot::NONE: out += "runnable"; break;
+        }
+        out += "\n";
+    }
+    return out;
+}
+
+/**
+ * @brief Abandon the schedule and release every managed thread.
+ *
+ * @param outcome Deadlock or livelock.
+ *
+ * @return void
+ */
+static void abort_schedule(ExploreResult::Outcome outcome) {
+    g_result.outcome = outcome;
+    g_result.blocked = describe_blocked();
+    g_aborted = true;
+    for (auto &s : g_slots) s->turn.notify_one();
+}
+
+/**
+ * @brief Pick the next thread among the runnable ones.
+ *
+ * @param runnable Runnable thread ids (not empty).
+ * @param self Calling thread.
+ * @param yielding The caller asked to let someone else run.
+ *
+ * @return int Next thread.
+ */
+static int choose(const std::vector<int> &runnable, int self, bool yielding) {
+    bool selfRunnable = g_slots[self]->state == Slot::RUNNABLE;
+    std::vector<int> candidates;
+    for (int t : runnable) {
+        if (!(yielding && t == self && runnable.size() > 1)) candidates.push_back(t);
+    }
+    switch (g_opts.strategy) {
+    case ExploreOptions::RANDOM:
+        return candidates[g_rng() % candidates.size()];
+    case ExploreOptions::PCT: {
+        int best = candidates[0];
+        for (int t : candidates) {
+            if (g_slots[t]->priority > g_slots[best]->priority) best = t;
+        }
+        return best;
+    }
+    case ExploreOptions::PREEMPT:
+        if (selfRunnable && !yielding) {
+            if (runnable.size() > 1 && g_result.preemptions < g_opts.bound && g_rng() % 16 == 0) {
+                int next;
+                do next = runnable[g_rng() % runnable.size()]; while (next == self);
+                return next;
+            }
+            return self;
+        }
+        return candidates[g_rng() % candidates.size()];
+    }
+    return candidates[0];
+}
+
+/**
+ * @brief One scheduling point: decide who runs next and wait for the turn.
+ *
+ * @param lk Lock on `g_mtx`.
+ * @param op What the caller is doing (for the decision log).
+ * @param yielding The caller asked to let someone else run.
+ *
+ * @return void
+ *
+ * @details The caller has already updated its own state (blocked, done or
+ *          still runnable). Returns when the caller has the turn again, or
+ *          right away if it is done or the schedule was abandoned; callers
+ *          check `g_aborted` afterwards.
+ */
+static void reschedule(std::unique_lock<std::mutex> &lk, const char* op, bool yielding = false) {
+    if (g_aborted) return;
+    int self = t_self;
+    long step = ++g_result.steps;
+    if (step > g_opts.maxSteps) { abort_schedule(ExploreResult::LIVELOCK); return; }
+    if (g_opts.strategy == ExploreOptions::PCT) {
+        for (std::size_t j = 0; j < g_changes.size(); ++j) {
+            if (g_changes[j] == step) g_slots[self]->priority = static_cast<long>(j);
+        }
+    }
+
+    std::vector<int> runnable, timed, waiting;
+    for (std::size_t i = 0; i < g_slots.size(); ++i) {
+        Slot &s = *g_slots[i];
+        if (s.state == Slot::RUNNABLE) runnable.push_back(static_cast<int>(i));
+        else if (s.state == Slot::BLOCKED && s.wait == Slot::CV) (s.timed ? timed : waiting).push_back(static_cast<int>(i));
+    }
+    // a timeout may fire at any point, and must once nothing else can run
+    if (!timed.empty() && (runnable.empty() || g_rng() % 8 == 0)) {
+        int t = timed[g_rng() % timed.size()];
+        wake(*g_slots[t]);
+        g_slots[t]->timedOut = true;
+        runnable.push_back(t);
+    }
+    if (g_opts.spurious && !waiting.empty() && g_rng() % 16 == 0) {
+        int t = waiting[g_rng() % waiting.size()];
+        wake(*g_slots[t]);
+        runnable.push_back(t);
+    }
+    if (runnable.empty()) {
+        for (auto &s : g_slots) {
+            if (s->state != Slot::DONE) { abort_schedule(ExploreResult::DEADLOCK); return; }
+        }
+        g_current = -1;
+        return;
+    }
+
+    int next = choose(runnable, self, yielding);
+    if (next != self && g_slots[self]->state == Slot::RUNNABLE && !yielding) g_result.preemptions++;
+    if (g_opts.verbose) {
+        g_result.log += std::to_string(step) + " " + g_slots[self]->name + ": " + op + " -> " + g_slots[next]->name + "\n";
+    }
+    if (next == self) return;
+    g_result.switches++;
+    g_current = next;
+    g_slots[next]->turn.notify_one();
+    if (g_slots[self]->state == Slot::DONE) return;
+    g_slots[self]->turn.wait(lk, [&]() { return g_current == self || g_aborted; });
+}
+
+/**
+ * @brief Start a schedule; the calling thread becomes managed thread 0.
+ *
+ * @param opts Strategy, seed and limits.
+ *
+ * @return void
+ */
+void explore_begin(const ExploreOptions &opts) {
+    std::lock_guard<std::mutex> lk(g_mtx);
+    g_opts = opts;
+    g_result = ExploreResult();
+    g_aborted = false;
+    g_rng.seed(opts.seed);
+    g_slots.clear();
+    g_slots.push_back(std::make_unique<Slot>());
+    g_slots[0]->name = "controller";
+    g_slots[0]->priority = opts.depth + static_cast<long>(g_rng() % 1000000);
+    g_changes.clear();
+    for (int j = 0; j + 1 < opts.depth; ++j) {
+        g_changes.push_back(1 + static_cast<long>(g_rng() % static_cast<std::uint64_t>(std::max(1L, opts.stepsHint))));
+    }
+    g_current = 0;
+    t_self = 0;
+}
+
+/**
+ * @brief Finish a schedule once every managed thread has been joined.
+ *
+ * @param void
+ *
+ * @return ExploreResult Outcome, step counts and, if verbose, the decision log.
+ */
+ExploreResult explore_end() {
+    std::lock_guard<std::mutex> lk(g_mtx);
+    ExploreResult r = std::move(g_result);
+    g_slots.clear();
+    g_current = -1;
+    t_self = -1;
+    return r;
+}
+
+/**
+ * @brief Name a managed thread in reports and the decision log.
+ *
+ * @param thread Thread id (0 = the controller, then in creation order).
+ * @param name Name.
+ *
+ * @return void
+ */
+void explore_name(int thread, std::string name) {
+    std::lock_guard<std::mutex> lk(g_mtx);
+    if (thread >= 0 && thread < static_cast<int>(g_slots.size())) g_slots[thread]->name = std::move(name);
+}
+
+void Mutex::lock() {
+    std::unique_lock<std::mutex> lk(g_mtx);
+    reschedule(lk, "lock");
+    while (!g_aborted && owner != -1) {
+        Slot &s = *g_slots[t_self];
+        s.state = Slot::BLOCKED;
+        s.wait = Slot::MUTEX;
+        s.on = this;
+        reschedule(lk, "blocked on lock");
+    }
+    if (g_aborted) throw ScheduleAborted{};
+    owner = t_self;
+}
+
+bool Mutex::try_lock() {
+    std::unique_lock<std::mutex> lk(g_mtx);
+    reschedule(lk, "try_lock");
+    if (g_aborted) throw ScheduleAborted{};
+    if (owner != -1) return false;
+    owner = t_self;
+    return true;
+}
+
+void Mutex::unlock() {
+    std::lock_guard<std::mutex> lk(g_mtx);
+    if (g_aborted) return;
+    owner = -1;
+    for (auto &s : g_slots) {
+        if (s->state == Slot::BLOCKED && s->wait == Slot::MUTEX && s->on == this) wake(*s);
+    }
+}
+
+/**
+ * @brief Release the mutex, block until notified (or timed out), then relock.
+ *
+ * @param lk Lock on the mutex.
+ * @param timed Whether the wait may time out.
+ *
+ * @return bool true if it timed out.
+ */
+bool CondVar::block(std::unique_lock<Mutex> &lk, bool timed) {
+    bool timedOut;
+    {
+        std::unique_lock<std::mutex> g(g_mtx);
+        if (g_aborted) throw ScheduleAborted{};
+        Mutex* m = lk.mutex();
+        m->owner = -1;
+        for (auto &s : g_slots) {
+            if (s->state == Slot::BLOCKED && s->wait == Slot::MUTEX && s->on == m) wake(*s);
+        }
+        Slot &self = *g_slots[t_self];
+        self.state = Slot::BLOCKED;
+        self.wait = Slot::CV;
+        self.on = this;
+        self.timed = timed;
+        self.timedOut = false;
+        reschedule(g, timed ? "timed wait" : "wait");
+        if (g_aborted) throw ScheduleAborted{};
+        timedOut = self.timedOut;
+        self.timed = self.timedOut = false;
+    }
+    lk.mutex()->lock();
+    return timedOut;
+}
+
+void CondVar::notify_one() {
+    std::unique_lock<std::mutex> lk(g_mtx);
+    if (g_aborted) return;
+    std::vector<Slot*> waiters;
+    for (auto &s : g_slots) {
+        if (s->state == Slot::BLOCKED && s->wait == Slot::CV && s->on == this) waiters.push_back(s.get());
+    }
+    if (!waiters.empty()) wake(*waiters[g_rng() % waiters.size()]);
+    reschedule(lk, "notify_one");
+    if (g_aborted) throw ScheduleAborted{};
+}
+
+void CondVar::notify_all() {
+    std::unique_lock<std::mutex> lk(g_mtx);
+    if (g_aborted) return;
+    for (auto &s : g_slots) {
+        if (s->state == Slot::BLOCKED && s->wait == Slot::CV && s->on == this) wake(*s);
+    }
+    reschedule(lk, "notify_all");
+    if (g_aborted) throw ScheduleAborted{};
+}
+
+/**
+ * @brief Register a new managed thread and start it; it runs once given the turn.
+ *
+ * @param fn Thread body.
+ *
+ * @return void
+ */
+void Thread::start(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lk(g_mtx);
+        id = static_cast<int>(g_slots.size());
+        g_slots.push_back(std::make_unique<Slot>());
+        g_slots[id]->name = "thread " + std::to_string(id);
+        g_slots[id]->priority = g_opts.depth + static_cast<long>(g_rng() % 1000000);
+    }
+    th = std::thread([id = id, fn = std::move(fn)]() {
+        t_self = id;
+        try {
+            {
+                std::unique_lock<std::mutex> lk(g_mtx);
+                g_slots[id]->turn.wait(lk, [&]() { return g_current == id || g_aborted; });
+                if (g_aborted) throw ScheduleAborted{};
+            }
+            fn();
+        } catch (const ScheduleAborted &) {
+        }
+        std::unique_lock<std::mutex> lk(g_mtx);
+        Slot &self = *g_slots[id];
+        self.state = Slot::DONE;
+        for (auto &s : g_slots) {
+            if (s->state == Slot::BLOCKED && s->wait == Slot::JOIN && s->on == &self) wake(*s);
+        }
+        reschedule(lk, "exit");
+        t_self = -1;
+    });
+}
+
+void Thread::join() {
+    {
+        std::unique_lock<std::mutex> lk(g_mtx);
+        while (!g_aborted && g_slots[id]->state != Slot::DONE) {
+            Slot &s = *g_slots[t_self];
+            s.state = Slot::BLOCKED;
+            s.wait = Slot::JOIN;
+            s.on = g_slots[id].get();
+            reschedule(lk, "join");
+        }
+    }
+    th.join();
+}
+
+void sync_yield() {
+    std::unique_lock<std::mutex> lk(g_mtx);
+    reschedule(lk, "yield", /*yielding=*/true);
+    if (g_aborted) throw ScheduleAborted{};
+}
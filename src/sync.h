@@ -0,0 +1,197 @@
+/**
+ * @file src/sync.h
+ *
+ * @brief Synchronization primitives of the engine, real or under a controlled scheduler.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The engine locks, waits, notifies, yields, sleeps and spawns threads only
+ * through the names defined here. Normally they are the standard types, so
+ * nothing changes. Built with `-DISLAND_EXPLORE` (`bin/island-explore`),
+ * they become instrumented versions driven by one deterministic scheduler:
+ *
+ * - Exactly one managed thread runs at a time. Every lock, wait, notify,
+ *   yield and sleep is a scheduling point where the scheduler picks the next
+ *   thread to run, seeded, so a schedule is reproducible from its seed.
+ * - Strategies: `random` (uniform among runnable threads), `pct`
+ *   (probabilistic concurrency testing: random priorities, always run the
+ *   highest, and at `depth - 1` random steps demote the running thread) and
+ *   `preempt` (keep running the current thread, with at most `bound`
+ *   random preemptions).
+ * - Sleeps take no time, and a timed wait times out whenever the scheduler
+ *   chooses to (or when nothing else can run). With `spurious` set, cv
+ *   waits may also return without a notification.
+ * - If no thread can run and some have not finished, the schedule has
+ *   deadlocked (a lost wakeup ends up here too). If it exceeds `maxSteps`,
+ *   it is reported as a livelock. Either way every managed thread is
+ *   unwound with `ScheduleAborted` so the next schedule can start.
+ */
+
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#ifndef ISLAND_EXPLORE
+
+using Mutex = std::mutex;
+using CondVar = std::condition_variable;
+using Thread = std::thread;
+
+inline void sync_yield() { std::this_thread::yield(); }
+
+template <class Rep, class Period>
+inline void sync_sleep_for(const std::chrono::duration<Rep, Period> &d) { std::this_thread::sleep_for(d); }
+
+#else
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+/**
+ * @struct ExploreOptions
+ *
+ * @brief How one schedule is chosen.
+ */
+struct ExploreOptions {
+    enum Strategy { RANDOM, PCT, PREEMPT } strategy = PCT;
+    std::uint64_t seed = 0;
+    int depth = 3;          // pct: priority change points + 1
+    int bound = 2;          // preempt: preemptions per schedule
+    long stepsHint = 1000;  // pct: expected scheduling points per schedule
+    long maxSteps = 200000; // livelock limit
+    bool spurious = false;  // allow spurious cv wakeups
+    bool verbose = false;   // keep the decision log
+};
+
+/**
+ * @struct ExploreResult
+ *
+ * @brief What happened to one schedule.
+ */
+struct ExploreResult {
+    enum Outcome { COMPLETED, DEADLOCK, LIVELOCK } outcome = COMPLETED;
+    long steps = 0;         // scheduling points
+    long switches = 0;      // context switches
+    int preemptions = 0;
+    std::string blocked;    // deadlock: who waits for what
+    std::string log;        // verbose: one line per scheduling decision
+};
+
+/**
+ * @struct ScheduleAborted
+ *
+ * @brief Thrown in every managed thread when a schedule is abandoned.
+ */
+struct ScheduleAborted {};
+
+void explore_begin(const ExploreOptions &opts);
+ExploreResult explore_end();
+void explore_name(int thread, std::string name);
+
+/**
+ * @class Mutex
+ *
+ * @brief Mutex whose acquisitions are scheduling points.
+ */
+class Mutex {
+public:
+    void lock();
+    bool try_lock();
+    void unlock();
+
+private:
+    friend class CondVar;
+    int owner = -1;
+};
+
+/**
+ * @class CondVar
+ *
+ * @brief Condition variable over `Mutex`; waits and notifies are scheduling points.
+ */
+class CondVar {
+public:
+    void wait(std::unique_lock<Mutex> &lk) { block(lk, false); }
+
+    template <class Pred>
+    void wait(std::unique_lock<Mutex> &lk, Pred pred) {
+        while (!pred()) wait(lk);
+    }
+
+    template <class Rep, class Period>
+    std::cv_status wait_for(std::unique_lock<Mutex> &lk, const std::chrono::duration<Rep, Period> &) {
+        return block(lk, true) ? std::cv_status::timeout : std::cv_status::no_timeout;
+    }
+
+    template <class Rep, class Period, class Pred>
+    bool wait_for(std::unique_lock<Mutex> &lk, const std::chrono::duration<Rep, Period> &d, Pred pred) {
+        while (!pred()) {
+            if (wait_for(lk, d) == std::cv_status::timeout) return pred();
+        }
+        return true;
+    }
+
+    template <class Clock, class Duration>
+    std::cv_status wait_until(std::unique_lock<Mutex> &lk, const std::chrono::time_point<Clock, Duration> &) {
+        return block(lk, true) ? std::cv_status::timeout : std::cv_status::no_timeout;
+    }
+
+    template <class Clock, class Duration, class Pred>
+    bool wait_until(std::unique_lock<Mutex> &lk, const std::chrono::time_point<Clock, Duration> &t, Pred pred) {
+        while (!pred()) {
+            if (wait_until(lk, t) == std::cv_status::timeout) return pred();
+        }
+        return true;
+    }
+
+    void notify_one();
+    void notify_all();
+
+private:
+    bool block(std::unique_lock<Mutex> &lk, bool timed);
+};
+
+/**
+ * @class Thread
+ *
+ * @brief Managed thread: registered with the scheduler before it starts.
+ */
+class Thread {
+public:
+    Thread() = default;
+
+    template <class F, class... Args>
+    explicit Thread(F &&f, Args &&...args) {
+        start(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    }
+
+    Thread(Thread &&) = default;
+    Thread &operator=(Thread &&) = default;
+
+    bool joinable() const { return th.joinable(); }
+    void join();
+
+private:
+    void start(std::function<void()> fn);
+
+    std::thread th;
+    int id = -1;
+};
+
+void sync_yield();
+
+template <class Rep, class Period>
+inline void sync_sleep_for(const std::chrono::duration<Rep, Period> &) { sync_yield(); }
+
+#endif
+
+#endif
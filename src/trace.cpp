@@ -0,0 +1,133 @@
+/**
+ * @file src/trace.cpp
+ *
+ * @brief Per-thread timeline recording and Chrome Trace Event Format export.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "trace.h"
+
+#include <cstdio>
+#include <fstream>
+
+/**
+ * @brief Display name of a trace state.
+ *
+ * @param s State.
+ *
+ * @return const char* Name shown on the span in the viewer.
+ */
+const char* trace_state_name(TraceState s) {
+    switch (s) {
+    case BLOCKED_CV: return "blocked on cv";
+    case WAIT_MUTEX: return "waiting for Boat::mtx";
+    case SEATED: return "seated";
+    case ROWING: return "rowing";
+    case IDLE: return "idle";
+    case SELECTING: return "selecting crew";
+    default: return "?";
+    }
+}
+
+/**
+ * @brief Append a span to this thread's timeline.
+ *
+ * @param state What the thread was doing.
+ * @param begin Start time (ns since trace start).
+ * @param end End time (ns since trace start).
+ *
+ * @return void
+ */
+void TraceBuffer::span(TraceState state, std::uint64_t begin, std::uint64_t end) {
+    TraceEvent e;
+    e.begin = begin;
+    e.end = end;
+    e.state = state;
+    events.push_back(e);
+}
+
+/**
+ * @brief Append an instant event (a marker without duration).
+ *
+ * @param what String literal naming the event.
+ * @param at Time (ns since trace start).
+ *
+ * @return void
+ */
+void TraceBuffer::instant(const char* what, std::uint64_t at) {
+    TraceEvent e;
+    e.begin = e.end = at;
+    e.name = what;
+    events.push_back(e);
+}
+
+/**
+ * @brief Start the trace clock.
+ */
+ChromeTrace::ChromeTrace() : start(std::chrono::steady_clock::now()) {}
+
+/**
+ * @brief Create the buffer for the calling thread.
+ *
+ * @param name Track name shown in the viewer.
+ * @param sortIndex Track order in the viewer (smaller first).
+ *
+ * @return TraceBuffer* Buffer owned by the trace; only the caller appends to it.
+ */
+TraceBuffer* ChromeTrace::thread(const std::string &name, long sortIndex) {
+    std::lock_guard<std::mutex> lk(mtx);
+    auto buf = std::make_unique<TraceBuffer>();
+    buf->tid = static_cast<int>(buffers.size()) + 1;
+    buf->name = name;
+    buf->sortIndex = sortIndex;
+    buf->events.reserve(256);
+    buffers.push_back(std::move(buf));
+    return buffers.back().get();
+}
+
+/**
+ * @brief Write all recorded events as Trace Event Format JSON.
+ *
+ * @param path Output file.
+ *
+ * @return true on success.
+ *
+ * @details Call only after every traced thread has been joined. Spans are
+ *          complete ("X") events, markers are thread-scoped instant ("i")
+ *          events, and each track gets thread_name/thread_sort_index
+ *          metadata. Times are microseconds.
+ */
+bool ChromeTrace::write(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    std::lock_guard<std::mutex> lk(mtx);
+    char num[64];
+    auto us = [&](std::uint64_t ns) {
+        std::snprintf(num, sizeof num, "%.3f", ns / 1000.0);
+        return num;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"island\"}}";
+    for (auto &b : buffers) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+            << ",\"args\":{\"name\":\"" << b->name << "\"}}";
+        out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+            << ",\"args\":{\"sort_index\":" << b->sortIndex << "}}";
+        for (auto &e : b->events) {
+            if (e.name) {
+                out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":"
+                    << b->tid << ",\"ts\":" << us(e.begin) << "}";
+            } else {
+                out << ",\n{\"name\":\"" << trace_state_name(e.state) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                    << b->tid << ",\"ts\":" << us(e.begin);
+                out << ",\"dur\":" << us(e.end - e.begin) << "}";
+            }
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
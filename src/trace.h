@@ -0,0 +1,122 @@
+/**
+ * @file src/trace.h
+ *
+ * @brief Per-thread timeline recording and Chrome Trace Event Format export.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * Every simulation thread records what it is doing into its own
+ * `TraceBuffer`, so recording never takes a shared lock. At the end of the
+ * run `ChromeTrace::write` turns all buffers into one JSON file that opens in
+ * Perfetto or chrome://tracing, one track per person plus the controller.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @enum TraceState
+ *
+ * @brief What a thread is doing during a span.
+ *
+ * - BLOCKED_CV: waiting on a condition variable for something to happen.
+ * - WAIT_MUTEX: waiting to acquire `Boat::mtx`.
+ * - SEATED: in the boat but not rowing (waiting for the crew or the arrival).
+ * - ROWING: the driver's travel time.
+ * - IDLE: on the mainland with no assignment; only needed if asked to row back.
+ * - SELECTING: the controller choosing and waking the next crew.
+ */
+enum TraceState { BLOCKED_CV, WAIT_MUTEX, SEATED, ROWING, IDLE, SELECTING, TRACE_STATE_COUNT };
+
+/**
+ * @struct TraceEvent
+ *
+ * @brief One span (`end > begin`) or instant (`name` set) on a thread's track.
+ */
+struct TraceEvent {
+    std::uint64_t begin = 0, end = 0; // ns since the trace started
+    TraceState state = IDLE;
+    const char* name = nullptr;       // instant events only (string literal)
+};
+
+/**
+ * @struct TraceBuffer
+ *
+ * @brief Events of a single thread; only that thread appends to it.
+ */
+struct TraceBuffer {
+    int tid = 0;
+    long sortIndex = 0;
+    std::string name;
+    std::vector<TraceEvent> events;
+
+    void span(TraceState state, std::uint64_t begin, std::uint64_t end);
+    void instant(const char* what, std::uint64_t at);
+};
+
+/**
+ * @class ChromeTrace
+ *
+ * @brief Owner of all thread buffers and the JSON writer.
+ */
+class ChromeTrace {
+public:
+    ChromeTrace();
+
+    TraceBuffer* thread(const std::string &name, long sortIndex);
+    bool write(const std::string &path) const;
+
+    std::uint64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+    mutable std::mutex mtx; // guards `buffers` (registration only)
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+/**
+ * @class TraceSpan
+ *
+ * @brief Records one span from construction until `end()` (or destruction).
+ *
+ * A null buffer makes every operation a no-op, so call sites stay the same
+ * whether or not tracing is enabled.
+ */
+class TraceSpan {
+public:
+    TraceSpan(const ChromeTrace* trace, TraceBuffer* buf, TraceState state)
+        : trace(trace), buf(buf), state(state), begin(buf ? trace->now() : 0) {}
+    ~TraceSpan() { end(); }
+
+    void end() {
+        if (!buf) return;
+        buf->span(state, begin, trace->now());
+        buf = nullptr;
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const ChromeTrace* trace;
+    TraceBuffer* buf;
+    TraceState state;
+    std::uint64_t begin;
+};
+
+const char* trace_state_name(TraceState s);
+
+#endif
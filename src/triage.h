@@ -0,0 +1,289 @@
+/**
+ * @file src/triage.h
+ *
+ * @brief Priority classes, deadlines and the heap index of the `priority` and `edf` policies.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * With `--priority-classes K` every person gets a class from 0 (most
+ * urgent, e.g. medical) to K-1, and with `--deadline S` a deadline: class k
+ * must reach the mainland within S * (k + 1) seconds of virtual time,
+ * jittered by +/-50% per person. Both are derived from the seed and the
+ * person's index, so the threaded run and the model assign them alike.
+ *
+ * Two policies use them. `priority` orders people by (class, deadline) and
+ * `edf` by (deadline, class); ties go to the lower id. Free people wait in
+ * `TriageQueues`, two binary heaps per shore and age like the queues of
+ * `dock.h`, one for rested people and one for people at the row limit, so
+ * a pick looks at two heap tops and costs O(log n) instead of a scan. On the island the most urgent person is on top; on the
+ * mainland the least urgent one is, since whoever rows back is stranded on
+ * the island again. The controller's crew steps stay the same, so boat
+ * composition and `MAX_CONSECUTIVE` are respected exactly as for the other
+ * policies: only who fills each seat changes.
+ *
+ * A person's evacuation time is their last landing on the mainland; they
+ * miss their deadline if that is later, or if they never get there.
+ */
+
+#ifndef TRIAGE_H
+#define TRIAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+#include "dock.h"
+#include "island.h"
+#include "policy.h"
+
+/**
+ * @struct Triage
+ *
+ * @brief How priority classes and deadlines are handed out.
+ */
+struct Triage {
+    int classes = 1;        // priority classes, 0 = most urgent
+    double deadline = 0;    // class-0 deadline in seconds, 0 = no deadlines
+    std::uint64_t seed = 0; // assignment stream
+};
+
+/**
+ * @brief Give one person the class and deadline of position `i`.
+ *
+ * @param p Person.
+ * @param triage Classes, deadline base and seed.
+ * @param i Position of the person in creation order.
+ *
+ * @return void
+ *
+ * @details Draws from a SplitMix64 hash of (seed, i), so the assignment
+ *          does not depend on anything but the position.
+ */
+template <typename P>
+void triage_person(P* p, const Triage &triage, std::size_t i) {
+    std::uint64_t z = triage.seed + 0x9E3779B97F4A7C15ULL * (i + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    p->priority = triage.classes > 1 ? static_cast<int>(z % static_cast<std::uint64_t>(triage.classes)) : 0;
+    double jitter = 0.5 + static_cast<double>(z >> 11) / 9007199254740992.0; // [0.5, 1.5)
+    p->deadline = triage.deadline > 0 ? triage.deadline * (p->priority + 1) * jitter : 0;
+}
+
+/**
+ * @brief Give every person a class and a deadline.
+ *
+ * @param people Container of people (objects or unique_ptrs), in creation order.
+ * @param triage Classes, deadline base and seed.
+ *
+ * @return void
+ */
+template <typename People>
+void assign_triage(People &people, const Triage &triage) {
+    for (std::size_t i = 0; i < people.size(); ++i) triage_person(as_ptr(people[i]), triage, i);
+}
+
+/**
+ * @class TriageQueues
+ *
+ * @brief Free people of one boat in four heaps (island/mainland x adult/child).
+ */
+template <class Ptr>
+class TriageQueues : public WaitingLine<Ptr> {
+public:
+    TriageQueues(bool edf, std::size_t adults, std::size_t children) : edf(edf) {
+        for (int shore = 0; shore < 2; ++shore) {
+            heaps[shore][0][0].reserve(children);
+            heaps[shore][1][0].reserve(adults);
+        }
+    }
+
+    /**
+     * @brief Add a free person to the heap of the shore they are on.
+     *
+     * @param p Person (`role == NONE`).
+     *
+     * @return void
+     */
+    void arrive(Ptr p) override {
+        std::vector<Ptr> &h = heap(p->position, p->isAdult, p->consecutiveRows >= MAX_CONSECUTIVE);
+        h.push_back(p);
+        std::push_heap(h.begin(), h.end(), Below{edf, p->position == MAINLAND});
+    }
+
+    /**
+     * @brief Take the top suitable person off a heap.
+     *
+     * @param wantAdult true for adult, false for child.
+     * @param where Shore.
+     * @param excludeNeedsBreak Skip people who need a break.
+     * @param preferRested Prefer people below the consecutive-row limit.
+     *
+     * @return Ptr The person, removed from the heap, or nullptr.
+     *
+     * @details O(log n): only the two heap tops are looked at. A person
+     *          needs a break exactly when they are at the row limit, so
+     *          `excludeNeedsBreak` rules out the tired heap. Without a
+     *          rested candidate the most urgent tired one is taken, like
+     *          the second pass of `select_person`.
+     */
+    Ptr take(bool wantAdult, Loc where, bool excludeNeedsBreak, bool preferRested = true) override {
+        std::vector<Ptr> &rested = heap(where, wantAdult, false);
+        std::vector<Ptr> &tired = heap(where, wantAdult, true);
+        Below below{edf, where == MAINLAND};
+        bool useTired = !excludeNeedsBreak && !tired.empty() &&
+                        (rested.empty() || (!preferRested && below(rested.front(), tired.front())));
+        std::vector<Ptr> &h = useTired ? tired : rested;
+        if (h.empty()) return nullptr;
+        std::pop_heap(h.begin(), h.end(), below);
+        Ptr p = h.back();
+        h.pop_back();
+        return p;
+    }
+
+    /**
+     * @brief List the contents of every heap.
+     *
+     * @param out Output: the waiting people.
+     *
+     * @return void
+     *
+     * @details The heap order is total (ties go to the id), so any arrival
+     *          order rebuilds heaps that pick the same people.
+     */
+    void line_up(std::vector<Ptr> &out) override {
+        for (auto &shore : heaps)
+            for (auto &age : shore)
+                for (auto &h : age) out.insert(out.end(), h.begin(), h.end());
+    }
+
+private:
+    // heap order: true if `a` belongs below `b`
+    struct Below {
+        bool edf, mainland;
+
+        static double due(Ptr p) {
+            return p->deadline > 0 ? p->deadline : std::numeric_limits<double>::infinity();
+        }
+        bool operator()(Ptr a, Ptr b) const {
+            auto key = [&](Ptr p) {
+                return edf ? std::make_tuple(due(p), static_cast<double>(p->priority), p->id)
+                           : std::make_tuple(static_cast<double>(p->priority), due(p), p->id);
+            };
+            // most urgent on top of the island, least urgent on top of the mainland
+            return mainland ? key(a) < key(b) : key(b) < key(a);
+        }
+    };
+
+    std::vector<Ptr> &heap(Loc where, bool adult, bool tired) { return heaps[where == MAINLAND][adult][tired]; }
+
+    bool edf;
+    std::vector<Ptr> heaps[2][2][2]; // shore, age, at the row limit
+};
+
+/**
+ * @brief Create the waiting line a policy keeps its free people in.
+ *
+ * @param policy Crew selection policy.
+ * @param adults Number of adults.
+ * @param children Number of children.
+ *
+ * @return std::unique_ptr<WaitingLine<Ptr>> Queues for fifo, heaps for
+ *         priority and edf, nullptr for the scanning policies.
+ */
+template <class Ptr>
+std::unique_ptr<WaitingLine<Ptr>> make_waiting_line(Policy policy, std::size_t adults, std::size_t children) {
+    switch (policy) {
+    case Policy::FIFO: return std::make_unique<DockQueues<Ptr>>();
+    case Policy::PRIORITY: return std::make_unique<TriageQueues<Ptr>>(false, adults, children);
+    case Policy::EDF: return std::make_unique<TriageQueues<Ptr>>(true, adults, children);
+    default: return nullptr;
+    }
+}
+
+/**
+ * @brief Whether a person missed their deadline.
+ *
+ * @param p Person.
+ *
+ * @return bool true if they have a deadline and reached the mainland after
+ *         it or never reached it at all.
+ */
+template <class P>
+bool missed_deadline(const P* p) {
+    return p->deadline > 0 && (p->position != MAINLAND || p->landedAt > p->deadline);
+}
+
+/**
+ * @brief Number of people who missed their deadline.
+ *
+ * @param people Container of people (objects or unique_ptrs).
+ *
+ * @return long Misses, counting people still off the mainland; people
+ *         without a deadline never miss.
+ */
+template <typename People>
+long deadline_misses(People &people) {
+    long missed = 0;
+    for (auto &e : people) {
+        if (missed_deadline(as_ptr(e))) missed++;
+    }
+    return missed;
+}
+
+/**
+ * @brief Print evacuation times and deadline misses by priority class.
+ *
+ * @param os Output stream.
+ * @param people Container of people (objects or unique_ptrs).
+ * @param triage Classes and deadline base the people were given.
+ *
+ * @return void
+ */
+template <typename People>
+void print_triage(std::ostream &os, People &people, const Triage &triage) {
+    std::ios::fmtflags flags = os.flags();
+    os << "Triage" << std::endl;
+    os << "Priority classes: " << triage.classes;
+    if (triage.deadline > 0) os << ", class-0 deadline: " << triage.deadline << " s";
+    os << std::endl << std::fixed << std::setprecision(1);
+    long total = 0, missedTotal = 0;
+    for (int c = 0; c < triage.classes; ++c) {
+        long n = 0, landed = 0, missed = 0;
+        double sum = 0, latest = 0;
+        for (auto &e : people) {
+            auto p = as_ptr(e);
+            if (p->priority != c) continue;
+            n++;
+            if (missed_deadline(p)) missed++;
+            if (p->position != MAINLAND) continue;
+            landed++;
+            sum += p->landedAt;
+            latest = std::max(latest, p->landedAt);
+        }
+        if (n == 0) continue;
+        os << "Class " << c << ": " << n << " people, evacuated at " << (landed ? sum / landed : 0)
+           << " s on average (last " << latest << " s)";
+        if (landed < n) os << ", stranded: " << n - landed;
+        if (triage.deadline > 0) os << ", deadlines missed: " << missed << " (" << 100.0 * missed / n << "%)";
+        os << std::endl;
+        total += n;
+        missedTotal += missed;
+    }
+    if (triage.deadline > 0 && total > 0) {
+        os << "Deadline miss rate: " << missedTotal << " of " << total << " (" << 100.0 * missedTotal / total
+           << "%)" << std::endl;
+    }
+    os.flags(flags);
+}
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file src/watchdog.cpp
+ *
+ * @brief Progress watchdog for the threaded simulation.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ */
+
+#include "watchdog.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+
+#include "engine.h"
+#include "flight.h"
+
+/**
+ * @brief Start watching.
+ *
+ * @param boat Boat whose `tripsCompleted` is watched.
+ * @param people People whose state is printed on a stall.
+ * @param interval Time without a completed trip that counts as a stall.
+ * @param abortOnStall Abort the process after reporting a stall.
+ */
+Watchdog::Watchdog(Boat &boat, const std::vector<std::unique_ptr<Person>> &people,
+                   std::chrono::milliseconds interval, bool abortOnStall)
+    : boat(boat), people(people), interval(interval), abortOnStall(abortOnStall) {
+    th = std::thread(&Watchdog::run, this);
+}
+
+/**
+ * @brief Stop the watchdog thread.
+ */
+Watchdog::~Watchdog() {
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        stopping = true;
+    }
+    cv.notify_one();
+    th.join();
+}
+
+/**
+ * @brief Watchdog thread body.
+ *
+ * @return void
+ *
+ * @details Checks the progress counter several times per interval so that a
+ *          stall is reported at most a fraction of the interval late.
+ *          `Boat::mtx` is only taken with `try_lock`: a stuck holder must not
+ *          also stall the watchdog, so without the lock the state is printed
+ *          as-is and marked as possibly inconsistent.
+ */
+void Watchdog::run() {
+    auto tick = interval / 4 > std::chrono::milliseconds(1) ? interval / 4 : std::chrono::milliseconds(1);
+    long last = boat.tripsCompleted.load(std::memory_order_relaxed);
+    auto lastChange = std::chrono::steady_clock::now();
+    bool reported = false;
+
+    std::unique_lock<std::mutex> lk(mtx);
+    while (!cv.wait_for(lk, tick, [&]{ return stopping; })) {
+        long now = boat.tripsCompleted.load(std::memory_order_relaxed);
+        auto t = std::chrono::steady_clock::now();
+        if (now != last) {
+            last = now;
+            lastChange = t;
+            reported = false;
+            continue;
+        }
+        if (reported || t - lastChange < interval) continue;
+
+        reported = true;
+        double idle = std::chrono::duration<double>(t - lastChange).count();
+        std::cerr << "watchdog: no trip completed for " << idle << " s (" << now << " trips so far)" << std::endl;
+        bool locked = boat.mtx.try_lock();
+        if (!locked) std::cerr << "watchdog: Boat::mtx is held, state below may be inconsistent" << std::endl;
+        print_state(boat, people, std::cerr);
+        if (locked) boat.mtx.unlock();
+        flight_dump("watchdog stall");
+        if (abortOnStall) {
+            std::cerr << "watchdog: aborting" << std::endl;
+            std::signal(SIGABRT, SIG_DFL); // already dumped above
+            std::abort();
+        }
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file src/watchdog.h
+ *
+ * @brief Progress watchdog for the threaded simulation.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * A separate thread samples `Boat::tripsCompleted` (an atomic the driver
+ * bumps after every trip). If it has not moved for the configured interval,
+ * the watchdog prints the boat, the shore counts and every person's state,
+ * followed by the flight recorder, and optionally aborts the process. It
+ * reports each stall once and re-arms when progress resumes.
+ */
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Boat;
+struct Person;
+
+/**
+ * @class Watchdog
+ *
+ * @brief Runs from construction until destruction.
+ */
+class Watchdog {
+public:
+    Watchdog(Boat &boat, const std::vector<std::unique_ptr<Person>> &people,
+             std::chrono::milliseconds interval, bool abortOnStall);
+    ~Watchdog();
+
+    Watchdog(const Watchdog &) = delete;
+    Watchdog &operator=(const Watchdog &) = delete;
+
+private:
+    void run();
+
+    Boat &boat;
+    const std::vector<std::unique_ptr<Person>> &people;
+    std::chrono::milliseconds interval;
+    bool abortOnStall;
+
+    std::mutex mtx; // guards `stopping`
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread th;
+};
+
+#endif
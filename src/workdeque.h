@@ -0,0 +1,134 @@
+/**
+ * @file src/workdeque.h
+ *
+ * @brief Chase-Lev work-stealing deque.
+ *
+ * @author Samii Shabuse <sus24@drexel.edu>
+ * @date November 16, 2025
+ *
+ * @section Overview
+ *
+ * The owning worker pushes and pops at the bottom without taking a lock;
+ * other workers steal from the top with one CAS. This is the C11 version of
+ * the algorithm (Lê, Pop, Cohen and Zappa Nardelli, PPoPP 2013), with the
+ * release fence in `push` folded into the store of `bottom`. The ring
+ * grows when full; old rings are kept until the deque is destroyed, since a
+ * thief may still be reading one, which bounds the waste to the final size.
+ */
+
+#ifndef WORKDEQUE_H
+#define WORKDEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class WorkDeque
+ *
+ * @brief Single-owner, multi-thief deque of small trivially copyable items.
+ */
+template <class T>
+class WorkDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied with atomic loads and stores");
+
+public:
+    explicit WorkDeque(std::size_t capacity = 64) {
+        std::size_t n = 1;
+        while (n < capacity) n <<= 1;
+        rings.push_back(std::make_unique<Ring>(n));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkDeque(const WorkDeque &) = delete;
+    WorkDeque &operator=(const WorkDeque &) = delete;
+
+    /**
+     * @brief Push at the bottom (owner only).
+     *
+     * @param x Item.
+     *
+     * @return void
+     */
+    void push(T x) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        Ring* a = ring.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(a->mask)) a = grow(a, t, b);
+        a->put(b, x);
+        bottom.store(b + 1, std::memory_order_release); // publishes the item to thieves
+    }
+
+    /**
+     * @brief Pop from the bottom (owner only).
+     *
+     * @param out Output item.
+     *
+     * @return bool false if the deque was empty or a thief took the last item.
+     */
+    bool pop(T &out) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* a = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if (t == b) {
+            // last item: race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Steal from the top (any thread).
+     *
+     * @param out Output item.
+     *
+     * @return bool false if the deque was empty or another thread won the race.
+     */
+    bool steal(T &out) {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        Ring* a = ring.load(std::memory_order_acquire);
+        T x = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return false;
+        out = x;
+        return true;
+    }
+
+private:
+    struct Ring {
+        explicit Ring(std::size_t n) : mask(n - 1), items(new std::atomic<T>[n]) {}
+        T get(std::int64_t i) const { return items[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T x) { items[i & mask].store(x, std::memory_order_relaxed); }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Ring* grow(Ring* a, std::int64_t t, std::int64_t b) {
+        rings.push_back(std::make_unique<Ring>(2 * (a->mask + 1)));
+        Ring* bigger = rings.back().get();
+        for (std::int64_t i = t; i < b; ++i) bigger->put(i, a->get(i));
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::atomic<Ring*> ring{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings; // owner only; every ring ever used
+};
+
+#endif